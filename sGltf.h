@@ -42,11 +42,30 @@
 #define S_GLTF_ASSERT(x) assert(x)
 #endif
 
+#include <stddef.h> // size_t
+
 #ifdef S_GLTF_IMPLEMENTATION
 #include <stdio.h>
 #include <stdlib.h>
 #endif // S_GLTF_IMPLEMENTATION
 
+//-----------------------------------------------------------------------------
+// Allocator interface (shared by Semper libraries)
+//-----------------------------------------------------------------------------
+
+#ifndef SEMPER_ALLOCATOR_INTERFACE
+#define SEMPER_ALLOCATOR_INTERFACE
+typedef void* (*sAllocatorRequestFunc)(void* userData, size_t size, size_t alignment);
+typedef void  (*sAllocatorReturnFunc) (void* userData, void* ptr);
+
+struct sAllocator
+{
+	sAllocatorRequestFunc request_memory; // returns nullptr on failure
+	sAllocatorReturnFunc  return_memory;  // may be a no-op (i.e. linear allocators)
+	void*                 userData;       // passed back to the functions above
+};
+#endif
+
 //-----------------------------------------------------------------------------
 // Forward Declarations
 //-----------------------------------------------------------------------------
@@ -87,7 +106,7 @@ typedef int sGLTFCameraType;
 //-----------------------------------------------------------------------------
 namespace Semper
 {
-	sGLTFModel load_gltf(const char* root, const char* file);
+	sGLTFModel load_gltf(const char* root, const char* file, sAllocator* allocator=nullptr); // allocator defaults to S_GLTF_ALLOC/S_GLTF_FREE
 	void       free_gltf(sGLTFModel& model);
 }
 
@@ -371,6 +390,7 @@ struct sGLTFModel
 	sGLTFAnimation*  animations;  // default nullptr
 	sGLTFSkin*       skins;       // default nullptr
 	char**           extensions;  // default nullptr
+	sAllocator*      allocator;   // default nullptr (S_GLTF_ALLOC/S_GLTF_FREE)
 
 	int      scene;            // default -1
 	unsigned scene_count;      // default 0u
@@ -416,8 +436,8 @@ typedef int sGltfJsonType; // enum -> sGltfJsonType_
 //-----------------------------------------------------------------------------
 namespace Semper
 {
-	sGltfJsonObject* load_json(char* rawData, int size);
-	void             free_json(sGltfJsonObject** rootObject);
+	sGltfJsonObject* load_json(char* rawData, int size, sAllocator* allocator=nullptr);
+	void             free_json(sGltfJsonObject** rootObject, sAllocator* allocator=nullptr);
 }
 
 //-----------------------------------------------------------------------------
@@ -489,26 +509,42 @@ struct sGltfJsonObject
 	inline sGltfJsonObject& operator[](int i)              { S_GLTF_ASSERT(children != nullptr); S_GLTF_ASSERT(i < childCount); return children[i]; };
 };
 
+static inline void*
+_gltf_alloc(sAllocator* allocator, size_t size)
+{
+	if(allocator) return allocator->request_memory(allocator->userData, size, 16);
+	return S_GLTF_ALLOC(size);
+}
+
+static inline void
+_gltf_free(sAllocator* allocator, void* ptr)
+{
+	if(allocator) allocator->return_memory(allocator->userData, ptr);
+	else          S_GLTF_FREE(ptr);
+}
+
 // borrowed from Dear ImGui
 template<typename T>
 struct sGltfVector_
 {
-	int size     = 0u;
-	int capacity = 0u;
-	T*  data     = nullptr;
-	inline sGltfVector_() { size = capacity = 0; data = nullptr; }
+	int         size      = 0u;
+	int         capacity  = 0u;
+	T*          data      = nullptr;
+	sAllocator* allocator = nullptr;
+	inline sGltfVector_() { size = capacity = 0; data = nullptr; allocator = nullptr; }
+	inline sGltfVector_(sAllocator* alloc) { size = capacity = 0; data = nullptr; allocator = alloc; }
 	inline sGltfVector_<T>& operator=(const sGltfVector_<T>& src) { clear(); resize(src.size); memcpy(data, src.data, (size_t)size * sizeof(T)); return *this; }
 	inline bool empty() const { return size == 0; }
 	inline int  size_in_bytes() const   { return size * (int)sizeof(T); }
 	inline T&   operator[](int i) { S_GLTF_ASSERT(i >= 0 && i < size); return data[i]; }
-	inline void clear() { if (data) { size = capacity = 0; S_GLTF_FREE(data); data = nullptr; } }
+	inline void clear() { if (data) { size = capacity = 0; _gltf_free(allocator, data); data = nullptr; } }
 	inline T*   begin() { return data; }
     inline T*   end() { return data + size; }
 	inline T&   back() { S_GLTF_ASSERT(size > 0); return data[size - 1]; }
-	inline void swap(sGltfVector_<T>& rhs) { int rhs_size = rhs.size; rhs.size = size; size = rhs_size; int rhs_cap = rhs.capacity; rhs.capacity = capacity; capacity = rhs_cap; T* rhs_data = rhs.data; rhs.data = data; data = rhs_data; }
+	inline void swap(sGltfVector_<T>& rhs) { int rhs_size = rhs.size; rhs.size = size; size = rhs_size; int rhs_cap = rhs.capacity; rhs.capacity = capacity; capacity = rhs_cap; T* rhs_data = rhs.data; rhs.data = data; data = rhs_data; sAllocator* rhs_alloc = rhs.allocator; rhs.allocator = allocator; allocator = rhs_alloc; }
 	inline int  _grow_capacity(int sz) { int new_capacity = capacity ? (capacity + capacity / 2) : 8; return new_capacity > sz ? new_capacity : sz; }
 	inline void resize(int new_size) { if (new_size > capacity) reserve(_grow_capacity(new_size)); size = new_size; }
-	inline void reserve(int new_capacity) { if (new_capacity <= capacity) return; T* new_data = (T*)S_GLTF_ALLOC((size_t)new_capacity * sizeof(T)); if (data) { memcpy(new_data, data, (size_t)size * sizeof(T)); S_GLTF_FREE(data); } data = new_data; capacity = new_capacity; }
+	inline void reserve(int new_capacity) { if (new_capacity <= capacity) return; T* new_data = (T*)_gltf_alloc(allocator, (size_t)new_capacity * sizeof(T)); if (data) { memcpy(new_data, data, (size_t)size * sizeof(T)); _gltf_free(allocator, data); } data = new_data; capacity = new_capacity; }
 	inline void push_back(const T& v) { if (size == capacity) reserve(_grow_capacity(size*2)); memcpy(&data[size], &v, sizeof(v)); size++;}
 	inline void pop_back() { S_GLTF_ASSERT(size > 0); size--; }
 };
@@ -547,14 +583,14 @@ struct sGltfStack_
 };
 
 static void
-_parse_for_tokens(char* rawData, sGltfVector_<sGltfToken_>& tokens)
+_parse_for_tokens(char* rawData, sGltfVector_<sGltfToken_>& tokens, sAllocator* allocator)
 {
 	int currentPos = 0u;
 	char currentChar = rawData[currentPos];
 	char basicTokens[] = { '{', '}', '[', ']', ':', ',' };
 
 	bool inString = false;
-	sGltfVector_<char> buffer;
+	sGltfVector_<char> buffer(allocator);
 
 	while (currentChar != 0)
 	{
@@ -568,6 +604,7 @@ _parse_for_tokens(char* rawData, sGltfVector_<sGltfToken_>& tokens)
 					if (!buffer.empty())
 					{
 						sGltfToken_ primitivetoken{};
+						primitivetoken.value.allocator = allocator;
 						primitivetoken.type = S_GLTF_JSON_TOKEN_PRIMITIVE;
 						buffer.push_back('\0');
 						for (int i = 0; i < buffer.size; i++)
@@ -580,6 +617,7 @@ _parse_for_tokens(char* rawData, sGltfVector_<sGltfToken_>& tokens)
 					}
 
 					sGltfToken_ token{};
+					token.value.allocator = allocator;
 					if      (currentChar == '{') token.type = S_GLTF_JSON_TOKEN_LEFT_BRACE;
 					else if (currentChar == '}') token.type = S_GLTF_JSON_TOKEN_RIGHT_BRACE;
 					else if (currentChar == '[') token.type = S_GLTF_JSON_TOKEN_LEFT_BRACKET;
@@ -605,6 +643,7 @@ _parse_for_tokens(char* rawData, sGltfVector_<sGltfToken_>& tokens)
 				if (inString)
 				{
 					sGltfToken_ token{};
+					token.value.allocator = allocator;
 					buffer.push_back('\0');
 					for (int i = 0; i < buffer.size; i++)
 					{
@@ -689,46 +728,47 @@ _remove_whitespace(char* rawData, char* spacesRemoved, size_t size)
 }
 
 static void
-_update_children_pointers(sGltfJsonObject* object, sGltfVector_<sGltfJsonObject*>* objects)
+_update_children_pointers(sGltfJsonObject* object, sGltfVector_<sGltfJsonObject*>* objects, sAllocator* allocator)
 {
 	S_GLTF_ASSERT(object->_internal);
 
 	if((*(sGltfVector_<int>*)(object->_internal)).empty())
 	{
-		S_GLTF_FREE(object->_internal);
+		_gltf_free(allocator, object->_internal);
 		object->_internal = nullptr;
 		return;
 	}
 
 	object->childCount = (*(sGltfVector_<int>*)(object->_internal)).size;
-	object->children = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject)*object->childCount);
+	object->children = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject)*object->childCount);
 	for(int i = 0; i < (*(sGltfVector_<int>*)(object->_internal)).size; i++)
 	{
 		object->children[i] = *(*objects)[(*(sGltfVector_<int>*)(object->_internal))[i]];
-		_update_children_pointers(&object->children[i], objects);
+		_update_children_pointers(&object->children[i], objects, allocator);
 	}
 
-	S_GLTF_FREE(object->_internal);
+	_gltf_free(allocator, object->_internal);
 	object->_internal = nullptr;
 }
 
 sGltfJsonObject*
-Semper::load_json(char* rawData, int size)
+Semper::load_json(char* rawData, int size, sAllocator* allocator)
 {
 	sGltfStack_ parentIDStack;
-	sGltfVector_<sGltfJsonObject*> objectArray;
+	parentIDStack.data.allocator = allocator;
+	sGltfVector_<sGltfJsonObject*> objectArray(allocator);
 
-	char* spacesRemoved = (char*)S_GLTF_ALLOC(sizeof(char)*size);
+	char* spacesRemoved = (char*)_gltf_alloc(allocator, sizeof(char)*size);
 	_remove_whitespace(rawData, spacesRemoved, size);
 
-	sGltfVector_<sGltfToken_>* tokens =  (sGltfVector_<sGltfToken_>*)S_GLTF_ALLOC(sizeof(sGltfVector_<sGltfToken_>));
-	new (tokens) sGltfVector_<sGltfToken_>();
-	_parse_for_tokens(spacesRemoved, *tokens);
+	sGltfVector_<sGltfToken_>* tokens =  (sGltfVector_<sGltfToken_>*)_gltf_alloc(allocator, sizeof(sGltfVector_<sGltfToken_>));
+	new (tokens) sGltfVector_<sGltfToken_>(allocator);
+	_parse_for_tokens(spacesRemoved, *tokens, allocator);
 
-	sGltfJsonObject *rootObject = (sGltfJsonObject *)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+	sGltfJsonObject *rootObject = (sGltfJsonObject *)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 	rootObject->type = S_GLTF_JSON_TYPE_OBJECT;
-	rootObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-	new (rootObject->_internal) sGltfVector_<int>();
+	rootObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+	new (rootObject->_internal) sGltfVector_<int>(allocator);
 	
 	objectArray.push_back(rootObject);
 	parentIDStack.push(0);
@@ -755,10 +795,10 @@ Semper::load_json(char* rawData, int size)
 			}
 			else
 			{
-				sGltfJsonObject *newObject = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+				sGltfJsonObject *newObject = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 				newObject->type = S_GLTF_JSON_TYPE_OBJECT;
-				newObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-				new (newObject->_internal) sGltfVector_<int>();
+				newObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+				new (newObject->_internal) sGltfVector_<int>(allocator);
 				objectArray.push_back(newObject);
 				parentIDStack.push(objectArray.size-1);
 				(*(sGltfVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);
@@ -776,10 +816,10 @@ Semper::load_json(char* rawData, int size)
 			}
 			else
 			{
-				sGltfJsonObject *newObject = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+				sGltfJsonObject *newObject = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 				newObject->type = S_GLTF_JSON_TYPE_ARRAY;
-				newObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-				new (newObject->_internal) sGltfVector_<int>();
+				newObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+				new (newObject->_internal) sGltfVector_<int>(allocator);
 				objectArray.push_back(newObject);
 				parentIDStack.push(objectArray.size-1);
 				(*(sGltfVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);	
@@ -805,10 +845,10 @@ Semper::load_json(char* rawData, int size)
 		case S_GLTF_JSON_TOKEN_MEMBER:
 		{
 
-			sGltfJsonObject* newObject = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+			sGltfJsonObject* newObject = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 			objectArray.push_back(newObject);
-			newObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-			new (newObject->_internal) sGltfVector_<int>();
+			newObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+			new (newObject->_internal) sGltfVector_<int>(allocator);
 			parentIDStack.push(objectArray.size-1);
 			(*(sGltfVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);
 			memcpy(newObject->name, (*tokens)[i].value.data, (*tokens)[i].value.size_in_bytes());
@@ -843,10 +883,10 @@ Semper::load_json(char* rawData, int size)
 			}
 			else // in array
 			{
-				sGltfJsonObject *newObject = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+				sGltfJsonObject *newObject = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 				newObject->type = S_GLTF_JSON_TYPE_STRING;
-				newObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-				new (newObject->_internal) sGltfVector_<int>();
+				newObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+				new (newObject->_internal) sGltfVector_<int>(allocator);
 				objectArray.push_back(newObject);
 				newObject->value = (*tokens)[i].value.data;
 				newObject->valueSize = (*tokens)[i].value.size_in_bytes();
@@ -866,13 +906,13 @@ Semper::load_json(char* rawData, int size)
 			}
 			else // in array
 			{
-				sGltfJsonObject *newObject = (sGltfJsonObject*)S_GLTF_ALLOC(sizeof(sGltfJsonObject));
+				sGltfJsonObject *newObject = (sGltfJsonObject*)_gltf_alloc(allocator, sizeof(sGltfJsonObject));
 				if((*tokens)[i].value.data[0] == 't')      newObject->type = S_GLTF_JSON_TYPE_BOOL;
 				else if((*tokens)[i].value.data[0] == 'f') newObject->type = S_GLTF_JSON_TYPE_BOOL;
 				else if((*tokens)[i].value.data[0] == 'n') newObject->type = S_GLTF_JSON_TYPE_NULL;
 				else                                       newObject->type = S_GLTF_JSON_TYPE_NUMBER;
-				newObject->_internal = (sGltfVector_<int>*)S_GLTF_ALLOC(sizeof(sGltfVector_<int>));
-				new (newObject->_internal) sGltfVector_<int>();
+				newObject->_internal = (sGltfVector_<int>*)_gltf_alloc(allocator, sizeof(sGltfVector_<int>));
+				new (newObject->_internal) sGltfVector_<int>(allocator);
 				objectArray.push_back(newObject);
 				newObject->value = (*tokens)[i].value.data;
 				newObject->valueSize = (*tokens)[i].value.size_in_bytes();
@@ -889,29 +929,29 @@ Semper::load_json(char* rawData, int size)
 
 	}
 	parentIDStack.pop();
-	_update_children_pointers(rootObject, &objectArray);
+	_update_children_pointers(rootObject, &objectArray, allocator);
 	objectArray.clear();
 	parentIDStack.data.clear();
 	return rootObject;
 }
 
 static void
-_free_json(sGltfJsonObject* object)
+_free_json(sGltfJsonObject* object, sAllocator* allocator)
 {
 	for(int i = 0; i < object->childCount; i++)
 	{
-		_free_json(&object->children[i]);
+		_free_json(&object->children[i], allocator);
 	}
 	if(object->childCount > 0)
-		S_GLTF_FREE(object->children);
+		_gltf_free(allocator, object->children);
 }
 
 void
-Semper::free_json(sGltfJsonObject** rootObjectPtr)
+Semper::free_json(sGltfJsonObject** rootObjectPtr, sAllocator* allocator)
 {
 	sGltfJsonObject* rootObject = *rootObjectPtr;
-	_free_json(rootObject);
-	S_GLTF_FREE(rootObject);
+	_free_json(rootObject, allocator);
+	_gltf_free(allocator, rootObject);
 	rootObjectPtr = nullptr;
 }
 
@@ -946,14 +986,14 @@ _find_in_string(const char* in, char str)
 }
 
 static sGltfVector_<char> 
-_base64_decode(const char* encoded_string)
+_base64_decode(const char* encoded_string, sAllocator* allocator)
 {
 	int in_len = strlen(encoded_string);
 	int i = 0;
 	int j = 0;
 	int in_ = 0;
 	unsigned char char_array_4[4], char_array_3[3];
-	sGltfVector_<char> ret;
+	sGltfVector_<char> ret(allocator);
 
 	static const char* base64_chars= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
@@ -986,14 +1026,14 @@ _base64_decode(const char* encoded_string)
 }
 
 static bool
-_decode_data_uri(unsigned char** out, const char* in, size_t reqBytes, bool checkSize, size_t* finalSize)
+_decode_data_uri(unsigned char** out, const char* in, size_t reqBytes, bool checkSize, size_t* finalSize, sAllocator* allocator)
 {
-	sGltfVector_<char> data;
+	sGltfVector_<char> data(allocator);
 	if(in[5] == 'a')
 	{
 		if(in[17] == 'o' || in[17] == 'g')
 		{
-			data = _base64_decode(&in[37]);  // cut mime string.
+			data = _base64_decode(&in[37], allocator);  // cut mime string.
 		}
 		else
 		{
@@ -1003,27 +1043,27 @@ _decode_data_uri(unsigned char** out, const char* in, size_t reqBytes, bool chec
 	else if(in[5] == 't')
 	{
 		//strncpy(mime_type, "text/plain", 16);
-		data = _base64_decode(&in[23]);  // cut mime string.
+		data = _base64_decode(&in[23], allocator);  // cut mime string.
 	}
 	else if(in[11] == 'j')
 	{
 		//strncpy(mime_type, "image/jpeg", 16);
-		data = _base64_decode(&in[23]);  // cut mime string.		
+		data = _base64_decode(&in[23], allocator);  // cut mime string.		
 	}
 	else if(in[11] == 'b')
 	{
 		//strncpy(mime_type, "image/bmp", 16);
-		data = _base64_decode(&in[22]);  // cut mime string.		
+		data = _base64_decode(&in[22], allocator);  // cut mime string.		
 	}
 	else if(in[11] == 'g')
 	{
 		//strncpy(mime_type, "image/gif", 16);
-		data = _base64_decode(&in[22]);  // cut mime string.		
+		data = _base64_decode(&in[22], allocator);  // cut mime string.		
 	}
 	else if(in[11] == 'p')
 	{
 		//strncpy(mime_type, "image/png", 16);
-		data = _base64_decode(&in[22]);  // cut mime string.
+		data = _base64_decode(&in[22], allocator);  // cut mime string.
 	}
 
 	if (data.empty()) 
@@ -1035,12 +1075,12 @@ _decode_data_uri(unsigned char** out, const char* in, size_t reqBytes, bool chec
 	{
 		if(data.size != reqBytes)
 			return false;
-		*out = (unsigned char*)S_GLTF_ALLOC(sizeof(unsigned char)*reqBytes);
+		*out = (unsigned char*)_gltf_alloc(allocator, sizeof(unsigned char)*reqBytes);
 		*finalSize = reqBytes;
 	}
 	else
 	{
-		*out = (unsigned char*)S_GLTF_ALLOC(sizeof(unsigned char)*data.size);
+		*out = (unsigned char*)_gltf_alloc(allocator, sizeof(unsigned char)*data.size);
 		*finalSize = data.size;
 	}
 
@@ -1049,18 +1089,18 @@ _decode_data_uri(unsigned char** out, const char* in, size_t reqBytes, bool chec
 }
 
 static char**
-_LoadExtensions(sGltfJsonObject& j, unsigned& size)
+_LoadExtensions(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	if (!j.doesMemberExist("extensionsUsed"))
 		return nullptr;
 
 	unsigned extensionCount = j["extensionsUsed"].childCount;
 
-	char** extensions = (char**)S_GLTF_ALLOC(sizeof(char*)*extensionCount);
+	char** extensions = (char**)_gltf_alloc(allocator, sizeof(char*)*extensionCount);
 
 	for (int i = 0; i < extensionCount; i++)
 	{
-		extensions[i] = (char*)S_GLTF_ALLOC(sizeof(char)*S_GLTF_MAX_NAME_LENGTH);
+		extensions[i] = (char*)_gltf_alloc(allocator, sizeof(char)*S_GLTF_MAX_NAME_LENGTH);
 		sGltfJsonObject& jExtension = j["extensionsUsed"][i];
 		strncpy(extensions[i], jExtension.value, S_GLTF_MAX_NAME_LENGTH);
 		size++;
@@ -1070,14 +1110,14 @@ _LoadExtensions(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFAnimation*
-_LoadAnimations(sGltfJsonObject& j, unsigned& size)
+_LoadAnimations(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* janimations = j.getMember("animations");
 	if(janimations == nullptr)
 		return nullptr;
 	size = janimations->childCount;
 
-	sGLTFAnimation* animations = (sGLTFAnimation*)S_GLTF_ALLOC(sizeof(sGLTFAnimation)*size);
+	sGLTFAnimation* animations = (sGLTFAnimation*)_gltf_alloc(allocator, sizeof(sGLTFAnimation)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1092,7 +1132,7 @@ _LoadAnimations(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jsamplers = janimation.getMember("samplers"))
 		{
 			animation.sampler_count = jsamplers->childCount;
-			animation.samplers = (sGLTFAnimationSampler*)S_GLTF_ALLOC(sizeof(sGLTFAnimationSampler)*animation.sampler_count);
+			animation.samplers = (sGLTFAnimationSampler*)_gltf_alloc(allocator, sizeof(sGLTFAnimationSampler)*animation.sampler_count);
 
 			for (int s = 0; s < animation.sampler_count; s++)
 			{
@@ -1107,7 +1147,7 @@ _LoadAnimations(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jchannels = janimation.getMember("channels"))
 		{
 			animation.channel_count = jchannels->childCount;
-			animation.channels = (sGLTFAnimationChannel*)S_GLTF_ALLOC(sizeof(sGLTFAnimationChannel)*animation.channel_count);
+			animation.channels = (sGLTFAnimationChannel*)_gltf_alloc(allocator, sizeof(sGLTFAnimationChannel)*animation.channel_count);
 
 			for (int i = 0; i < animation.channel_count; i++)
 			{
@@ -1128,14 +1168,14 @@ _LoadAnimations(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFCamera*
-_LoadCameras(sGltfJsonObject& j, unsigned& size)
+_LoadCameras(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jcameras = j.getMember("cameras");
 	if(jcameras == nullptr)
 		return nullptr;
 	size = jcameras->childCount;
 
-	sGLTFCamera* cameras = (sGLTFCamera*)S_GLTF_ALLOC(sizeof(sGLTFCamera)*size);
+	sGLTFCamera* cameras = (sGLTFCamera*)_gltf_alloc(allocator, sizeof(sGLTFCamera)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1167,13 +1207,13 @@ _LoadCameras(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFScene*
-_LoadScenes(sGltfJsonObject& j, unsigned& size)
+_LoadScenes(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jscenes = j.getMember("scenes");
 	if(jscenes == nullptr)
 		return nullptr;
 	size = jscenes->childCount;
-	sGLTFScene* scenes = (sGLTFScene*)S_GLTF_ALLOC(sizeof(sGLTFScene)*size);
+	sGLTFScene* scenes = (sGLTFScene*)_gltf_alloc(allocator, sizeof(sGLTFScene)*size);
 	for (int i = 0; i < size; i++)
 	{
 		sGltfJsonObject& jscene = (*jscenes)[0];
@@ -1183,7 +1223,7 @@ _LoadScenes(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jnodes = jscene.getMember("nodes"))
 		{
 			scene.node_count = jnodes->childCount;
-			scene.nodes = (unsigned*)S_GLTF_ALLOC(sizeof(unsigned)*scene.node_count);
+			scene.nodes = (unsigned*)_gltf_alloc(allocator, sizeof(unsigned)*scene.node_count);
 			for (int j = 0; j < scene.node_count; j++)
 			{
 				int node = (*jnodes)[j].asInt();
@@ -1195,13 +1235,13 @@ _LoadScenes(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFNode*
-_LoadNodes(sGltfJsonObject& j, unsigned& size)
+_LoadNodes(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jnodes = j.getMember("nodes");
 	if(jnodes == nullptr)
 		return nullptr;
 	size = jnodes->childCount;
-	sGLTFNode* nodes = (sGLTFNode*)S_GLTF_ALLOC(sizeof(sGLTFNode)*size);
+	sGLTFNode* nodes = (sGLTFNode*)_gltf_alloc(allocator, sizeof(sGLTFNode)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1238,7 +1278,7 @@ _LoadNodes(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jchildren = jnode.getMember("children"))
 		{
 			node.child_count = jchildren->childCount;
-			node.children = (unsigned*)S_GLTF_ALLOC(sizeof(unsigned)*node.child_count);
+			node.children = (unsigned*)_gltf_alloc(allocator, sizeof(unsigned)*node.child_count);
 			for (int j = 0; j < node.child_count; j++)
 			{
 				unsigned child = (*jchildren)[j].asFloat();
@@ -1250,13 +1290,13 @@ _LoadNodes(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFMesh*
-_LoadMeshes(sGltfJsonObject& j, unsigned& size)
+_LoadMeshes(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jmeshes = j.getMember("meshes");
 	if(jmeshes == nullptr)
 		return nullptr;
 	size = jmeshes->childCount;
-	sGLTFMesh* meshes = (sGLTFMesh*)S_GLTF_ALLOC(sizeof(sGLTFMesh)*size);
+	sGLTFMesh* meshes = (sGLTFMesh*)_gltf_alloc(allocator, sizeof(sGLTFMesh)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1271,7 +1311,7 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jweights = jmesh.getMember("weights"))
 		{
 			mesh.weights_count = (*jweights).childCount;
-			mesh.weights = (float*)S_GLTF_ALLOC(sizeof(float)*mesh.weights_count);
+			mesh.weights = (float*)_gltf_alloc(allocator, sizeof(float)*mesh.weights_count);
 			for (int j = 0; j < mesh.weights_count; j++)
 			{
 				sGltfJsonObject m = (*jweights)[j];
@@ -1282,7 +1322,7 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jprimitives = jmesh.getMember("primitives"))
 		{
 			mesh.primitives_count = jprimitives->childCount;
-			mesh.primitives = (sGLTFMeshPrimitive*)S_GLTF_ALLOC(sizeof(sGLTFMeshPrimitive)*mesh.primitives_count);
+			mesh.primitives = (sGLTFMeshPrimitive*)_gltf_alloc(allocator, sizeof(sGLTFMeshPrimitive)*mesh.primitives_count);
 
 			for (int j = 0; j < mesh.primitives_count; j++)
 			{
@@ -1299,7 +1339,7 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 				if (sGltfJsonObject* jattributes = jprimitive.getMember("attributes"))
 				{
 					primitive.attribute_count = jattributes->childCount;
-					primitive.attributes = (sGLTFAttribute*)S_GLTF_ALLOC(sizeof(sGLTFAttribute)*primitive.attribute_count);
+					primitive.attributes = (sGLTFAttribute*)_gltf_alloc(allocator, sizeof(sGLTFAttribute)*primitive.attribute_count);
 					
 					for (int k = 0; k < primitive.attribute_count; k++)
 					{
@@ -1312,7 +1352,7 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 				if (sGltfJsonObject* jtargets = jprimitive.getMember("targets"))
 				{
 					primitive.target_count = jtargets->childCount;
-					primitive.targets = (sGLTFMorphTarget*)S_GLTF_ALLOC(sizeof(sGLTFMorphTarget)*primitive.target_count);
+					primitive.targets = (sGLTFMorphTarget*)_gltf_alloc(allocator, sizeof(sGLTFMorphTarget)*primitive.target_count);
 
 					for (int k = 0; k < primitive.target_count; k++)
 					{
@@ -1320,7 +1360,7 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 						sGltfJsonObject& jtarget = (*jtargets)[k];
 						
 						target.attribute_count = jtarget.childCount;
-						target.attributes = (sGLTFAttribute*)S_GLTF_ALLOC(sizeof(sGLTFAttribute)*target.attribute_count);
+						target.attributes = (sGLTFAttribute*)_gltf_alloc(allocator, sizeof(sGLTFAttribute)*target.attribute_count);
 						for (int x = 0; x < target.attribute_count; x++)
 						{
 							sGltfJsonObject& jattribute = jtarget[x];
@@ -1336,13 +1376,13 @@ _LoadMeshes(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFMaterial*
-_LoadMaterials(sGltfJsonObject& j, unsigned& size)
+_LoadMaterials(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jmaterials = j.getMember("materials");
 	if(jmaterials == nullptr)
 		return nullptr;
 	size = jmaterials->childCount;
-	sGLTFMaterial* materials = (sGLTFMaterial*)S_GLTF_ALLOC(sizeof(sGLTFMaterial)*size);
+	sGLTFMaterial* materials = (sGLTFMaterial*)_gltf_alloc(allocator, sizeof(sGLTFMaterial)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1451,13 +1491,13 @@ _LoadMaterials(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFTexture*
-_LoadTextures(sGltfJsonObject& j, unsigned& size)
+_LoadTextures(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jtextures = j.getMember("textures");
 	if(jtextures == nullptr)
 		return nullptr;
 	size = jtextures->childCount;
-	sGLTFTexture* textures = (sGLTFTexture*)S_GLTF_ALLOC(sizeof(sGLTFTexture)*size);
+	sGLTFTexture* textures = (sGLTFTexture*)_gltf_alloc(allocator, sizeof(sGLTFTexture)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1471,13 +1511,13 @@ _LoadTextures(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFSampler*
-_LoadSamplers(sGltfJsonObject& j, unsigned& size)
+_LoadSamplers(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jsamplers = j.getMember("samplers");
 	if(jsamplers == nullptr)
 		return nullptr;
 	size = jsamplers->childCount;
-	sGLTFSampler* samplers = (sGLTFSampler*)S_GLTF_ALLOC(sizeof(sGLTFSampler)*size);
+	sGLTFSampler* samplers = (sGLTFSampler*)_gltf_alloc(allocator, sizeof(sGLTFSampler)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1493,13 +1533,13 @@ _LoadSamplers(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFImage*
-_LoadImages(sGltfJsonObject& j, unsigned& size)
+_LoadImages(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jimages = j.getMember("images");
 	if(jimages == nullptr)
 		return nullptr;
 	size = jimages->childCount;
-	sGLTFImage* images = (sGLTFImage*)S_GLTF_ALLOC(sizeof(sGLTFImage)*size);
+	sGLTFImage* images = (sGLTFImage*)_gltf_alloc(allocator, sizeof(sGLTFImage)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1508,7 +1548,7 @@ _LoadImages(sGltfJsonObject& j, unsigned& size)
 		sGltfJsonObject* foundImage = jimage.getMember("uri");
 		if(foundImage)
 		{
-			image.uri = (char*)S_GLTF_ALLOC(sizeof(char)*foundImage->valueSize+1);
+			image.uri = (char*)_gltf_alloc(allocator, sizeof(char)*foundImage->valueSize+1);
 			strncpy(image.uri, foundImage->asString(), foundImage->valueSize);
 			image.uri[foundImage->valueSize] = 0;
 		}
@@ -1526,13 +1566,13 @@ _LoadImages(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFBuffer*
-_LoadBuffers(sGltfJsonObject& j, unsigned& size)
+_LoadBuffers(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jbuffers = j.getMember("buffers");
 	if(jbuffers == nullptr)
 		return nullptr;
 	size = jbuffers->childCount;
-	sGLTFBuffer* buffers = (sGLTFBuffer*)S_GLTF_ALLOC(sizeof(sGLTFBuffer)*size);
+	sGLTFBuffer* buffers = (sGLTFBuffer*)_gltf_alloc(allocator, sizeof(sGLTFBuffer)*size);
 	for (int i = 0; i < size; i++)
 	{
 		sGltfJsonObject& jbuffer = (*jbuffers)[i];
@@ -1540,7 +1580,7 @@ _LoadBuffers(sGltfJsonObject& j, unsigned& size)
 		sGltfJsonObject* foundBuffer = jbuffer.getMember("uri");
 		if(foundBuffer)
 		{
-			buffer.uri = (char*)S_GLTF_ALLOC(sizeof(char)*foundBuffer->valueSize+1);
+			buffer.uri = (char*)_gltf_alloc(allocator, sizeof(char)*foundBuffer->valueSize+1);
 			strncpy(buffer.uri, foundBuffer->asString(), foundBuffer->valueSize);
 			buffer.uri[foundBuffer->valueSize] = 0;
 		}
@@ -1556,13 +1596,13 @@ _LoadBuffers(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFBufferView*
-_LoadBufferViews(sGltfJsonObject& j, unsigned& size)
+_LoadBufferViews(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jbufferViews = j.getMember("bufferViews");
 	if(jbufferViews == nullptr)
 		return nullptr;
 	size = jbufferViews->childCount;
-	sGLTFBufferView* bufferviews = (sGLTFBufferView*)S_GLTF_ALLOC(sizeof(sGLTFBufferView)*size);
+	sGLTFBufferView* bufferviews = (sGLTFBufferView*)_gltf_alloc(allocator, sizeof(sGLTFBufferView)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1578,13 +1618,13 @@ _LoadBufferViews(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFAccessor*
-_LoadAccessors(sGltfJsonObject& j, unsigned& size)
+_LoadAccessors(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jaccessors = j.getMember("accessors");
 	if(jaccessors == nullptr)
 		return nullptr;
 	size = jaccessors->childCount;
-	sGLTFAccessor* accessors = (sGLTFAccessor*)S_GLTF_ALLOC(sizeof(sGLTFAccessor)*size);
+	sGLTFAccessor* accessors = (sGLTFAccessor*)_gltf_alloc(allocator, sizeof(sGLTFAccessor)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1612,13 +1652,13 @@ _LoadAccessors(sGltfJsonObject& j, unsigned& size)
 }
 
 static sGLTFSkin*
-_LoadSkins(sGltfJsonObject& j, unsigned& size)
+_LoadSkins(sGltfJsonObject& j, unsigned& size, sAllocator* allocator)
 {
 	sGltfJsonObject* jskins = j.getMember("skins");
 	if(jskins == nullptr)
 		return nullptr;
 	size = jskins->childCount;
-	sGLTFSkin* skins = (sGLTFSkin*)S_GLTF_ALLOC(sizeof(sGLTFSkin)*size);
+	sGLTFSkin* skins = (sGLTFSkin*)_gltf_alloc(allocator, sizeof(sGLTFSkin)*size);
 
 	for (int i = 0; i < size; i++)
 	{
@@ -1633,7 +1673,7 @@ _LoadSkins(sGltfJsonObject& j, unsigned& size)
 		if (sGltfJsonObject* jjoints = jnode.getMember("joints"))
 		{
 			skin.joints_count = jjoints->childCount;
-			skin.joints = (unsigned*)S_GLTF_ALLOC(sizeof(unsigned)*skin.joints_count);
+			skin.joints = (unsigned*)_gltf_alloc(allocator, sizeof(unsigned)*skin.joints_count);
 			jjoints->asUIntArray(skin.joints, skin.joints_count);
 		}
 	}
@@ -1641,7 +1681,7 @@ _LoadSkins(sGltfJsonObject& j, unsigned& size)
 }
 
 static char*
-_ReadFile(const char* file, unsigned& size, const char* mode)
+_ReadFile(const char* file, unsigned& size, const char* mode, sAllocator* allocator)
 {
 	FILE* dataFile = fopen(file, mode);
 
@@ -1659,7 +1699,7 @@ _ReadFile(const char* file, unsigned& size, const char* mode)
 		fseek(dataFile, 0, SEEK_SET);
 
 		// allocate memory to contain the whole file:
-		char* data = (char*)S_GLTF_ALLOC(sizeof(char)*size);
+		char* data = (char*)_gltf_alloc(allocator, sizeof(char)*size);
 
 		// copy the file into the buffer:
 		size_t result = fread(data, sizeof(char), size, dataFile);
@@ -1680,15 +1720,16 @@ _ReadFile(const char* file, unsigned& size, const char* mode)
 }
 
 static sGLTFModel
-sLoadBinaryGLTF(const char* root, const char* file)
+sLoadBinaryGLTF(const char* root, const char* file, sAllocator* allocator)
 {
 
 	sGLTFModel model{};
 	model.root = root;
 	model.name = file;
+	model.allocator = allocator;
 
 	unsigned dataSize = 0u;
-	char* data = (char*)_ReadFile(file, dataSize, "rb");
+	char* data = (char*)_ReadFile(file, dataSize, "rb", allocator);
 
 	unsigned magic = *(unsigned*)&data[0];
 	unsigned version = *(unsigned*)&data[4];
@@ -1704,22 +1745,22 @@ sLoadBinaryGLTF(const char* root, const char* file)
 		return model;
 	}
 
-	sGltfJsonObject* rootObject = Semper::load_json(chunkData, chunkLength);
+	sGltfJsonObject* rootObject = Semper::load_json(chunkData, chunkLength, allocator);
 	model.scene = rootObject->getIntMember("scene", 0);
-	model.scenes = _LoadScenes(*rootObject, model.scene_count);
-	model.nodes = _LoadNodes(*rootObject, model.node_count);
-	model.materials = _LoadMaterials(*rootObject, model.material_count);
-	model.meshes = _LoadMeshes(*rootObject, model.mesh_count);
-	model.textures = _LoadTextures(*rootObject, model.texture_count);
-	model.samplers = _LoadSamplers(*rootObject, model.sampler_count);
-	model.images = _LoadImages(*rootObject, model.image_count);
-	model.buffers = _LoadBuffers(*rootObject, model.buffer_count);
-	model.bufferviews = _LoadBufferViews(*rootObject, model.bufferview_count);
-	model.accessors = _LoadAccessors(*rootObject, model.accessor_count);
-	model.cameras = _LoadCameras(*rootObject, model.camera_count);
-	model.animations = _LoadAnimations(*rootObject, model.animation_count);
-	model.extensions = _LoadExtensions(*rootObject, model.extension_count);
-	model.skins = _LoadSkins(*rootObject, model.skin_count);
+	model.scenes = _LoadScenes(*rootObject, model.scene_count, allocator);
+	model.nodes = _LoadNodes(*rootObject, model.node_count, allocator);
+	model.materials = _LoadMaterials(*rootObject, model.material_count, allocator);
+	model.meshes = _LoadMeshes(*rootObject, model.mesh_count, allocator);
+	model.textures = _LoadTextures(*rootObject, model.texture_count, allocator);
+	model.samplers = _LoadSamplers(*rootObject, model.sampler_count, allocator);
+	model.images = _LoadImages(*rootObject, model.image_count, allocator);
+	model.buffers = _LoadBuffers(*rootObject, model.buffer_count, allocator);
+	model.bufferviews = _LoadBufferViews(*rootObject, model.bufferview_count, allocator);
+	model.accessors = _LoadAccessors(*rootObject, model.accessor_count, allocator);
+	model.cameras = _LoadCameras(*rootObject, model.camera_count, allocator);
+	model.animations = _LoadAnimations(*rootObject, model.animation_count, allocator);
+	model.extensions = _LoadExtensions(*rootObject, model.extension_count, allocator);
+	model.skins = _LoadSkins(*rootObject, model.skin_count, allocator);
 
 	if (chunkLength + 20 != length)
 	{
@@ -1728,7 +1769,7 @@ sLoadBinaryGLTF(const char* root, const char* file)
 		char* datachunkData = &data[28 + chunkLength];
 
 		model.buffers[0].dataCount = model.buffers[0].byte_length;
-		model.buffers[0].data = (unsigned char*)S_GLTF_ALLOC(sizeof(char)*model.buffers[0].dataCount);
+		model.buffers[0].data = (unsigned char*)_gltf_alloc(allocator, sizeof(char)*model.buffers[0].dataCount);
 		memcpy(model.buffers[0].data, datachunkData, model.buffers[0].byte_length);
 		int a = 6;
 	}
@@ -1745,7 +1786,7 @@ sLoadBinaryGLTF(const char* root, const char* file)
 			char* bufferRawData = (char*)model.buffers[bufferView.buffer_index].data;
 			char* bufferRawSection = &bufferRawData[bufferView.byte_offset]; // start of buffer section
 			image.dataCount = bufferView.byte_length;
-			image.data = (unsigned char*)S_GLTF_ALLOC(sizeof(char)*image.dataCount);
+			image.data = (unsigned char*)_gltf_alloc(allocator, sizeof(char)*image.dataCount);
 			memcpy(image.data, bufferRawSection, bufferView.byte_length);
 			continue;
 		}
@@ -1753,7 +1794,7 @@ sLoadBinaryGLTF(const char* root, const char* file)
 		if (_is_data_uri(image.uri))
 		{
 			image.embedded = true;
-			if (!_decode_data_uri(&image.data, image.uri, 0, false, &image.dataCount))
+			if (!_decode_data_uri(&image.data, image.uri, 0, false, &image.dataCount, allocator))
 			{
 				assert(false && "here");
 			}
@@ -1778,7 +1819,7 @@ sLoadBinaryGLTF(const char* root, const char* file)
 
 		if (_is_data_uri(buffer.uri))
 		{
-			if (!_decode_data_uri(&buffer.data, buffer.uri, buffer.byte_length, true, &buffer.dataCount))
+			if (!_decode_data_uri(&buffer.data, buffer.uri, buffer.byte_length, true, &buffer.dataCount, allocator))
 			{
 				assert(false && "here");
 			}
@@ -1789,34 +1830,35 @@ sLoadBinaryGLTF(const char* root, const char* file)
 			strcpy(&combinedFile[strlen(model.root)], buffer.uri);
 
 			unsigned dataSize = 0u;
-			void* bufferdata = _ReadFile(combinedFile, dataSize, "rb");
+			void* bufferdata = _ReadFile(combinedFile, dataSize, "rb", allocator);
 			buffer.dataCount = dataSize;
-			buffer.data = (unsigned char*)S_GLTF_ALLOC(sizeof(char)*buffer.dataCount);
+			buffer.data = (unsigned char*)_gltf_alloc(allocator, sizeof(char)*buffer.dataCount);
 			memcpy(buffer.data, bufferdata, dataSize);
-			S_GLTF_FREE(bufferdata);
+			_gltf_free(allocator, bufferdata);
 		}
 
 	}
 
-	Semper::free_json(&rootObject);
-	S_GLTF_FREE(data);
+	Semper::free_json(&rootObject, allocator);
+	_gltf_free(allocator, data);
 	return model;
 }
 
 sGLTFModel
-Semper::load_gltf(const char* root, const char* file)
+Semper::load_gltf(const char* root, const char* file, sAllocator* allocator)
 {
 
 	size_t len = strlen(file);
 	if (file[len - 1] == 'b')
-		return sLoadBinaryGLTF(root, file);
+		return sLoadBinaryGLTF(root, file, allocator);
 
 	sGLTFModel model{};
 	model.root = root;
 	model.name = file;
+	model.allocator = allocator;
 
 	unsigned dataSize = 0u;
-	char* data = _ReadFile(file, dataSize, "rb");
+	char* data = _ReadFile(file, dataSize, "rb", allocator);
 
 	if (dataSize == 0u)
 	{
@@ -1824,23 +1866,23 @@ Semper::load_gltf(const char* root, const char* file)
 		return model;
 	}
 
-	sGltfJsonObject* rootObject = load_json(data, dataSize);
-	S_GLTF_FREE(data);
+	sGltfJsonObject* rootObject = load_json(data, dataSize, allocator);
+	_gltf_free(allocator, data);
 	model.scene = rootObject->getIntMember("scene", 0);
-	model.scenes = _LoadScenes(*rootObject, model.scene_count);
-	model.nodes = _LoadNodes(*rootObject, model.node_count);
-	model.materials = _LoadMaterials(*rootObject, model.material_count);
-	model.meshes = _LoadMeshes(*rootObject, model.mesh_count);
-	model.textures = _LoadTextures(*rootObject, model.texture_count);
-	model.samplers = _LoadSamplers(*rootObject, model.sampler_count);
-	model.images = _LoadImages(*rootObject, model.image_count);
-	model.buffers = _LoadBuffers(*rootObject, model.buffer_count);
-	model.bufferviews = _LoadBufferViews(*rootObject, model.bufferview_count);
-	model.accessors = _LoadAccessors(*rootObject, model.accessor_count);
-	model.cameras = _LoadCameras(*rootObject, model.camera_count);
-	model.animations = _LoadAnimations(*rootObject, model.animation_count);
-	model.extensions = _LoadExtensions(*rootObject, model.extension_count);
-	model.skins = _LoadSkins(*rootObject, model.skin_count);
+	model.scenes = _LoadScenes(*rootObject, model.scene_count, allocator);
+	model.nodes = _LoadNodes(*rootObject, model.node_count, allocator);
+	model.materials = _LoadMaterials(*rootObject, model.material_count, allocator);
+	model.meshes = _LoadMeshes(*rootObject, model.mesh_count, allocator);
+	model.textures = _LoadTextures(*rootObject, model.texture_count, allocator);
+	model.samplers = _LoadSamplers(*rootObject, model.sampler_count, allocator);
+	model.images = _LoadImages(*rootObject, model.image_count, allocator);
+	model.buffers = _LoadBuffers(*rootObject, model.buffer_count, allocator);
+	model.bufferviews = _LoadBufferViews(*rootObject, model.bufferview_count, allocator);
+	model.accessors = _LoadAccessors(*rootObject, model.accessor_count, allocator);
+	model.cameras = _LoadCameras(*rootObject, model.camera_count, allocator);
+	model.animations = _LoadAnimations(*rootObject, model.animation_count, allocator);
+	model.extensions = _LoadExtensions(*rootObject, model.extension_count, allocator);
+	model.skins = _LoadSkins(*rootObject, model.skin_count, allocator);
 
 	for (unsigned i = 0; i < model.image_count; i++)
 	{
@@ -1849,7 +1891,7 @@ Semper::load_gltf(const char* root, const char* file)
 		if (_is_data_uri(image.uri))
 		{
 			image.embedded = true;
-			if (!_decode_data_uri(&image.data, image.uri, 0, false, &image.dataCount))
+			if (!_decode_data_uri(&image.data, image.uri, 0, false, &image.dataCount, allocator))
 			{
 				assert(false && "here");
 			}
@@ -1870,7 +1912,7 @@ Semper::load_gltf(const char* root, const char* file)
 
 		if (_is_data_uri(buffer.uri))
 		{
-			if (!_decode_data_uri(&buffer.data, buffer.uri, buffer.byte_length, true, &buffer.dataCount))
+			if (!_decode_data_uri(&buffer.data, buffer.uri, buffer.byte_length, true, &buffer.dataCount, allocator))
 			{
 				assert(false && "here");
 			}
@@ -1881,21 +1923,22 @@ Semper::load_gltf(const char* root, const char* file)
 			strcpy(&combinedFile[strlen(model.root)], buffer.uri);
 
 			unsigned dataSize = 0u;
-			void* data = _ReadFile(combinedFile, dataSize, "rb");
+			void* data = _ReadFile(combinedFile, dataSize, "rb", allocator);
 			buffer.dataCount = dataSize;
-			buffer.data = (unsigned char*)S_GLTF_ALLOC(sizeof(char)*buffer.dataCount);
+			buffer.data = (unsigned char*)_gltf_alloc(allocator, sizeof(char)*buffer.dataCount);
 			memcpy(buffer.data, data, dataSize);
 		}
 
 	}
 
-	Semper::free_json(&rootObject);
+	Semper::free_json(&rootObject, allocator);
 	return model;
 }
 
 void
 Semper::free_gltf(sGLTFModel& model)
 {
+	sAllocator* allocator = model.allocator;
 
 	for (unsigned i = 0; i < model.mesh_count; i++)
 	{
@@ -1904,74 +1947,74 @@ Semper::free_gltf(sGLTFModel& model)
 			
 			for (unsigned k = 0; k < model.meshes[i].primitives[j].target_count; k++)
 			{
-				S_GLTF_FREE(model.meshes[i].primitives[j].targets[k].attributes);
+				_gltf_free(allocator, model.meshes[i].primitives[j].targets[k].attributes);
 			}
-			S_GLTF_FREE(model.meshes[i].primitives[j].targets);
-			S_GLTF_FREE(model.meshes[i].primitives[j].attributes);
+			_gltf_free(allocator, model.meshes[i].primitives[j].targets);
+			_gltf_free(allocator, model.meshes[i].primitives[j].attributes);
 		}
-		S_GLTF_FREE(model.meshes[i].weights);
-		S_GLTF_FREE(model.meshes[i].primitives);
+		_gltf_free(allocator, model.meshes[i].weights);
+		_gltf_free(allocator, model.meshes[i].primitives);
 	}
 
 
 	for (unsigned i = 0; i < model.node_count; i++)
 	{
 		if (model.nodes[i].children)
-			S_GLTF_FREE(model.nodes[i].children);
+			_gltf_free(allocator, model.nodes[i].children);
 	}
 
 	for (unsigned i = 0; i < model.scene_count; i++)
 	{
 		if (model.scenes[i].nodes)
-			S_GLTF_FREE(model.scenes[i].nodes);
+			_gltf_free(allocator, model.scenes[i].nodes);
 	}
 
 	for (unsigned i = 0; i < model.animation_count; i++)
 	{
 		if (model.animations[i].sampler_count > 0)
-			S_GLTF_FREE(model.animations[i].samplers);
+			_gltf_free(allocator, model.animations[i].samplers);
 		if (model.animations[i].channel_count > 0)
-			S_GLTF_FREE(model.animations[i].channels);
+			_gltf_free(allocator, model.animations[i].channels);
 	}
 
 	for (unsigned i = 0; i < model.skin_count; i++)
 	{
 		if (model.skins[i].joints_count > 0)
-			S_GLTF_FREE(model.skins[i].joints);
+			_gltf_free(allocator, model.skins[i].joints);
 	}
 
 	for (unsigned i = 0; i < model.extension_count; i++)
 	{
-		S_GLTF_FREE(model.extensions[i]);
+		_gltf_free(allocator, model.extensions[i]);
 	}
 
 	for (unsigned i = 0; i < model.image_count; i++)
 	{
 		if(model.images[i].uri)
-			S_GLTF_FREE(model.images[i].uri);
+			_gltf_free(allocator, model.images[i].uri);
 	}
 
 	for (unsigned i = 0; i < model.buffer_count; i++)
 	{
 		if(model.buffers[i].uri)
-			S_GLTF_FREE(model.buffers[i].uri);
+			_gltf_free(allocator, model.buffers[i].uri);
 	}
 
-	S_GLTF_FREE(model.scenes);
-	S_GLTF_FREE(model.nodes);
-	S_GLTF_FREE(model.meshes);
-	S_GLTF_FREE(model.materials);
-	S_GLTF_FREE(model.textures);
-	S_GLTF_FREE(model.samplers);
-	S_GLTF_FREE(model.images);
-	S_GLTF_FREE(model.buffers);
-	S_GLTF_FREE(model.bufferviews);
-	S_GLTF_FREE(model.accessors);
-	S_GLTF_FREE(model.cameras);
-	S_GLTF_FREE(model.animations);
-	S_GLTF_FREE(model.extensions);
-	S_GLTF_FREE(model.skins);
-	S_GLTF_FREE(model.extensions);
+	_gltf_free(allocator, model.scenes);
+	_gltf_free(allocator, model.nodes);
+	_gltf_free(allocator, model.meshes);
+	_gltf_free(allocator, model.materials);
+	_gltf_free(allocator, model.textures);
+	_gltf_free(allocator, model.samplers);
+	_gltf_free(allocator, model.images);
+	_gltf_free(allocator, model.buffers);
+	_gltf_free(allocator, model.bufferviews);
+	_gltf_free(allocator, model.accessors);
+	_gltf_free(allocator, model.cameras);
+	_gltf_free(allocator, model.animations);
+	_gltf_free(allocator, model.extensions);
+	_gltf_free(allocator, model.skins);
+	_gltf_free(allocator, model.extensions);
 
 	model.scenes = nullptr;
 	model.nodes = nullptr;
@@ -25,6 +25,7 @@
 #endif
 
 #include <stdlib.h>
+#include <stddef.h> // size_t
 #include <stdio.h>
 #include <string.h> // strncpy()
 
@@ -41,6 +42,23 @@
 #define S_INI_FREE(x) free(x)
 #endif
 
+//-----------------------------------------------------------------------------
+// [SECTION] Allocator interface (shared by Semper libraries)
+//-----------------------------------------------------------------------------
+
+#ifndef SEMPER_ALLOCATOR_INTERFACE
+#define SEMPER_ALLOCATOR_INTERFACE
+typedef void* (*sAllocatorRequestFunc)(void* userData, size_t size, size_t alignment);
+typedef void  (*sAllocatorReturnFunc) (void* userData, void* ptr);
+
+struct sAllocator
+{
+    sAllocatorRequestFunc request_memory; // returns nullptr on failure
+    sAllocatorReturnFunc  return_memory;  // may be a no-op (i.e. linear allocators)
+    void*                 userData;       // passed back to the functions above
+};
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Forward declarations and basic types
 //-----------------------------------------------------------------------------
@@ -54,7 +72,7 @@ typedef int sIniType; // enum -> sIniType_
 //-----------------------------------------------------------------------------
 namespace Semper
 {
-    sIniFile load_ini_file   (const char* file);
+    sIniFile load_ini_file   (const char* file, sAllocator* allocator=nullptr); // allocator defaults to S_INI_ALLOC/S_INI_FREE
     void     save_ini_file   (const char* file, sIniFile* iniFile);
     void     cleanup_ini_file(sIniFile* iniFile);
 }
@@ -121,12 +139,13 @@ struct sIniSection
 {
     char       section[S_INI_MAX_NAME_LENGTH];
     char       subsection[S_INI_MAX_NAME_LENGTH];
-    sIniEntry* entries;
-    size_t     entrySize;
-    size_t     entryCapacity;
+    sIniEntry*  entries;
+    size_t      entrySize;
+    size_t      entryCapacity;
+    sAllocator* allocator; // nullptr -> S_INI_ALLOC/S_INI_FREE
 
-    void       initialize(const char* section, size_t entryCapacity=0);
-    void       initialize(const char* name, const char* sub, size_t capacity=0);
+    void       initialize(const char* section, size_t entryCapacity=0, sAllocator* allocator=nullptr);
+    void       initialize(const char* name, const char* sub, size_t capacity=0, sAllocator* allocator=nullptr);
     sIniEntry* get_entry(const char* name);
     bool       has_entry(const char* name);
 
@@ -169,8 +188,9 @@ struct sIniFile
     sIniSection* sections;
     size_t       sectionCount;
     size_t       _capacity;
+    sAllocator*  allocator; // nullptr -> S_INI_ALLOC/S_INI_FREE
     
-    void         initialize(size_t sectionCapacity=0);
+    void         initialize(size_t sectionCapacity=0, sAllocator* allocator=nullptr);
     sIniSection* get_section(const char* name, const char* sub=nullptr);
     bool         has_section(const char* name, const char* sub=nullptr);
     sIniSection* add_section(const char* name, const char* sub, size_t capacity=0);
@@ -182,18 +202,33 @@ struct sIniFile
 
 #ifdef SEMPER_INI_IMPLEMENTATION
 
+static inline void*
+_ini_alloc(sAllocator* allocator, size_t size)
+{
+    if(allocator) return allocator->request_memory(allocator->userData, size, 16);
+    return S_INI_ALLOC(size);
+}
+
+static inline void
+_ini_free(sAllocator* allocator, void* ptr)
+{
+    if(allocator) allocator->return_memory(allocator->userData, ptr);
+    else          S_INI_FREE(ptr);
+}
+
 static void _grow_ini_file(sIniFile* file)
 {
+    sAllocator* allocator = file->allocator;
     if(file->_capacity == 0)
     {
         file->_capacity = 16;
-        file->sections = (sIniSection*)S_INI_ALLOC(sizeof(sIniSection)*file->_capacity);
+        file->sections = (sIniSection*)_ini_alloc(allocator, sizeof(sIniSection)*file->_capacity);
         return;
     }
     sIniSection* oldMemory = file->sections;
-    file->sections = (sIniSection*)S_INI_ALLOC(sizeof(sIniSection)*file->_capacity*2);
+    file->sections = (sIniSection*)_ini_alloc(allocator, sizeof(sIniSection)*file->_capacity*2);
     memcpy(file->sections, oldMemory, sizeof(sIniSection)*file->_capacity);
-    S_INI_FREE(oldMemory);
+    _ini_free(allocator, oldMemory);
     file->_capacity*=2;
 }
 
@@ -226,19 +261,20 @@ sIniFile::has_section(const char* name, const char* sub)
 }
 
 void
-sIniFile::initialize(size_t sectionCapacity)
+sIniFile::initialize(size_t sectionCapacity, sAllocator* fileAllocator)
 {
+    allocator = fileAllocator;
     sectionCount = 0u;
     _capacity = sectionCapacity;
     if(sectionCapacity == 0) _capacity = 16;
-    sections = (sIniSection*)S_INI_ALLOC(sizeof(sIniSection)*_capacity);       
+    sections = (sIniSection*)_ini_alloc(allocator, sizeof(sIniSection)*_capacity);       
 }
 
 sIniSection*
 sIniFile::add_section(const char* name, const char* sub, size_t capacity)
 {
     if(sectionCount >= _capacity) _grow_ini_file(this);
-    sections[sectionCount].initialize(name, sub, capacity);
+    sections[sectionCount].initialize(name, sub, capacity, allocator);
     sectionCount++;
     return &sections[sectionCount-1];
 }
@@ -250,24 +286,26 @@ sIniFile::add_section(const char* name, size_t capacity)
 }
 
 void
-sIniSection::initialize(const char* name, const char* sub, size_t capacity)
+sIniSection::initialize(const char* name, const char* sub, size_t capacity, sAllocator* sectionAllocator)
 {  
+    allocator = sectionAllocator;
     if(capacity == 0) capacity = 16;
     section[0] = '?'; subsection[0] = entrySize = 0;
     if(name)   strncpy(section, name, S_INI_MAX_NAME_LENGTH);
     if(sub)    strncpy(subsection, sub, S_INI_MAX_NAME_LENGTH);
-    entryCapacity = capacity; entries = (sIniEntry*)S_INI_ALLOC(sizeof(sIniEntry)*entryCapacity);
+    entryCapacity = capacity; entries = (sIniEntry*)_ini_alloc(allocator, sizeof(sIniEntry)*entryCapacity);
 }
 
 void
-sIniSection::initialize(const char* section, size_t entryCapacity) 
+sIniSection::initialize(const char* section, size_t entryCapacity, sAllocator* sectionAllocator) 
 { 
-    initialize(section, nullptr, entryCapacity);
+    initialize(section, nullptr, entryCapacity, sectionAllocator);
 }
 
 static void
 _cleanup_ini_section(sIniSection* section)
 {
+    sAllocator* allocator = section->allocator;
     for(int i = 0; i < section->entrySize; i++)
     {
         sIniEntry& entry = section->entries[i];
@@ -277,16 +315,16 @@ _cleanup_ini_section(sIniSection* section)
             case S_INI_TYPE_NUMBER:  entry._data=nullptr; entry.numberValue=0.0; break;
             case S_INI_TYPE_BOOL:    entry._data=nullptr; entry.boolValue=false; break;
             case S_INI_TYPE_NUMBER_ARRAY:
-            case S_INI_TYPE_BOOL_ARRAY: entry.length=0; S_INI_FREE(entry._data); entry._data = nullptr; break;
-            case S_INI_TYPE_STRING: S_INI_FREE(entry.stringValue); entry._data=nullptr; entry.stringValue=nullptr; break;
+            case S_INI_TYPE_BOOL_ARRAY: entry.length=0; _ini_free(allocator, entry._data); entry._data = nullptr; break;
+            case S_INI_TYPE_STRING: _ini_free(allocator, entry.stringValue); entry._data=nullptr; entry.stringValue=nullptr; break;
             case S_INI_TYPE_STRING_ARRAY:
             {
                 for(int j = 0; j < entry.length; j++)
                 {
-                    S_INI_FREE(entry.stringArrayValue[j]);
+                    _ini_free(allocator, entry.stringArrayValue[j]);
                     entry.stringArrayValue[j] = nullptr;
                 }
-                S_INI_FREE(entry.stringArrayValue);
+                _ini_free(allocator, entry.stringArrayValue);
                 entry.stringArrayValue = nullptr;
                 entry.length=0;
                 break;
@@ -296,7 +334,7 @@ _cleanup_ini_section(sIniSection* section)
         entry.type = S_INI_TYPE_NONE;
     }
 
-    S_INI_FREE(section->entries);
+    _ini_free(allocator, section->entries);
     section->entries = nullptr;
     section->entrySize=0;
     section->entryCapacity=0;
@@ -309,16 +347,17 @@ _cleanup_ini_section(sIniSection* section)
 
 static void _grow_ini_section(sIniSection* section)
 {
+    sAllocator* allocator = section->allocator;
     if(section->entryCapacity == 0)
     {
         section->entryCapacity = 16;
-        section->entries = (sIniEntry*)S_INI_ALLOC(sizeof(sIniEntry)*section->entryCapacity);
+        section->entries = (sIniEntry*)_ini_alloc(allocator, sizeof(sIniEntry)*section->entryCapacity);
         return;
     }
     sIniEntry* oldMemory = section->entries;
-    section->entries = (sIniEntry*)S_INI_ALLOC(sizeof(sIniEntry)*section->entryCapacity*2);
+    section->entries = (sIniEntry*)_ini_alloc(allocator, sizeof(sIniEntry)*section->entryCapacity*2);
     memcpy(section->entries, oldMemory, sizeof(sIniEntry)*section->entryCapacity);
-    S_INI_FREE(oldMemory);
+    _ini_free(allocator, oldMemory);
     section->entryCapacity*=2;
 }
 
@@ -386,7 +425,7 @@ sIniSection::add_entry(const char* name, const char* value)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].stringValue = (char*)S_INI_ALLOC(sizeof(char)*(strlen(value)+1));
+    entries[entrySize].stringValue = (char*)_ini_alloc(allocator, sizeof(char)*(strlen(value)+1));
     strcpy(entries[entrySize].stringValue, value);
     entries[entrySize].stringArrayValue = nullptr;
     entries[entrySize].type = S_INI_TYPE_STRING;
@@ -399,7 +438,7 @@ sIniSection::add_entry(const char* name, int* value, int size)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].numberArrayValue = (double*)S_INI_ALLOC(size*sizeof(double));
+    entries[entrySize].numberArrayValue = (double*)_ini_alloc(allocator, size*sizeof(double));
     for(int i = 0; i < size; i++) entries[entrySize].numberArrayValue[i] = (double)value[i];
     entries[entrySize].length = size;
     entries[entrySize].type = S_INI_TYPE_NUMBER_ARRAY;
@@ -412,7 +451,7 @@ sIniSection::add_entry(const char* name, float* value, int size)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].numberArrayValue = (double*)S_INI_ALLOC(size*sizeof(double));
+    entries[entrySize].numberArrayValue = (double*)_ini_alloc(allocator, size*sizeof(double));
     for(int i = 0; i < size; i++) entries[entrySize].numberArrayValue[i] = (double)value[i];
     entries[entrySize].length = size;
     entries[entrySize].type = S_INI_TYPE_NUMBER_ARRAY;
@@ -425,7 +464,7 @@ sIniSection::add_entry(const char* name, double* value, int size)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].numberArrayValue = (double*)S_INI_ALLOC(size*sizeof(double));
+    entries[entrySize].numberArrayValue = (double*)_ini_alloc(allocator, size*sizeof(double));
     memcpy(entries[entrySize].numberArrayValue, value, size*sizeof(double));
     entries[entrySize].length = size;
     entries[entrySize].type = S_INI_TYPE_NUMBER_ARRAY;
@@ -438,7 +477,7 @@ sIniSection::add_entry(const char* name, bool* value, int size)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].boolArrayValue = (bool*)S_INI_ALLOC(size*sizeof(bool));
+    entries[entrySize].boolArrayValue = (bool*)_ini_alloc(allocator, size*sizeof(bool));
     memcpy(entries[entrySize].boolArrayValue, value, size*sizeof(bool));
     entries[entrySize].length = size;
     entries[entrySize].type = S_INI_TYPE_BOOL_ARRAY;
@@ -451,10 +490,10 @@ sIniSection::add_entry(const char* name, const char** value, int size)
 {
     if(entrySize >= entryCapacity) _grow_ini_section(this);
     strncpy(entries[entrySize].name, name, S_INI_MAX_NAME_LENGTH);
-    entries[entrySize].stringArrayValue = (char**)S_INI_ALLOC(size*sizeof(char*));
+    entries[entrySize].stringArrayValue = (char**)_ini_alloc(allocator, size*sizeof(char*));
     for(int i = 0; i < size; i++)
     {
-        entries[entrySize].stringArrayValue[i] = (char*)S_INI_ALLOC((strlen(value[i])+1)*sizeof(char*));
+        entries[entrySize].stringArrayValue[i] = (char*)_ini_alloc(allocator, (strlen(value[i])+1)*sizeof(char*));
         
         strcpy(entries[entrySize].stringArrayValue[i], value[i]);
         auto blah = entries[entrySize].stringArrayValue[i];
@@ -467,12 +506,13 @@ sIniSection::add_entry(const char* name, const char** value, int size)
 }
 
 sIniFile
-Semper::load_ini_file(const char* file)
+Semper::load_ini_file(const char* file, sAllocator* allocator)
 {
     sIniFile result;
     result.sectionCount = 0u;
     result.sections = nullptr;
     result._capacity = 0u;
+    result.allocator = allocator;
 
 	FILE* dataFile = fopen(file, "r");
 
@@ -512,7 +552,7 @@ Semper::load_ini_file(const char* file)
 
     fseek(dataFile, 0, SEEK_SET);
 
-    result.sections = (sIniSection*)S_INI_ALLOC(sizeof(sIniSection)*result._capacity);
+    result.sections = (sIniSection*)_ini_alloc(allocator, sizeof(sIniSection)*result._capacity);
 
     // preallocate entries
     {
@@ -538,9 +578,10 @@ Semper::load_ini_file(const char* file)
             {
                 if(currentSectionIndex != -1)
                 {
-                    result.sections[currentSectionIndex].entries = (sIniEntry*)S_INI_ALLOC(sizeof(sIniEntry)*currentEntryCount);
+                    result.sections[currentSectionIndex].entries = (sIniEntry*)_ini_alloc(allocator, sizeof(sIniEntry)*currentEntryCount);
                     result.sections[currentSectionIndex].entryCapacity = currentEntryCount;
                     result.sections[currentSectionIndex].entrySize = 0;
+                    result.sections[currentSectionIndex].allocator = allocator;
                     result.sections[currentSectionIndex].section[0] = 0;
                     result.sections[currentSectionIndex].subsection[0] = 0;
                 }
@@ -554,9 +595,10 @@ Semper::load_ini_file(const char* file)
             }
             currentEntryCount++;
         }
-        result.sections[currentSectionIndex].entries = (sIniEntry*)S_INI_ALLOC(sizeof(sIniEntry)*currentEntryCount);
+        result.sections[currentSectionIndex].entries = (sIniEntry*)_ini_alloc(allocator, sizeof(sIniEntry)*currentEntryCount);
         result.sections[currentSectionIndex].entryCapacity = currentEntryCount;
         result.sections[currentSectionIndex].entrySize = 0;
+        result.sections[currentSectionIndex].allocator = allocator;
         result.sections[currentSectionIndex].section[0] = 0;
         result.sections[currentSectionIndex].subsection[0] = 0;
     }
@@ -704,7 +746,7 @@ Semper::load_ini_file(const char* file)
             {
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].type = S_INI_TYPE_BOOL_ARRAY;
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].length = valueCount;
-                result.sections[currentSize].entries[result.sections[currentSize].entrySize].boolArrayValue = (bool*)S_INI_ALLOC(valueCount*sizeof(bool));
+                result.sections[currentSize].entries[result.sections[currentSize].entrySize].boolArrayValue = (bool*)_ini_alloc(allocator, valueCount*sizeof(bool));
                 char currentSubChar = lineBuffer[currentPos];
                 int currentValuePos = 0;
                 while(currentSubChar != 0)
@@ -753,13 +795,13 @@ Semper::load_ini_file(const char* file)
             {
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].type = S_INI_TYPE_STRING_ARRAY;
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].length = valueCount;
-                result.sections[currentSize].entries[result.sections[currentSize].entrySize].stringArrayValue = (char**)S_INI_ALLOC(valueCount*sizeof(char*));
+                result.sections[currentSize].entries[result.sections[currentSize].entrySize].stringArrayValue = (char**)_ini_alloc(allocator, valueCount*sizeof(char*));
 
                 currentPos++;
                 for(int i = 0; i < valueCount; i++)
                 {
                     auto lengthOfCurrentString = strlen(&lineBuffer[currentPos]);
-                    result.sections[currentSize].entries[result.sections[currentSize].entrySize].stringArrayValue[i] = (char*)S_INI_ALLOC((lengthOfCurrentString+1)*sizeof(char));
+                    result.sections[currentSize].entries[result.sections[currentSize].entrySize].stringArrayValue[i] = (char*)_ini_alloc(allocator, (lengthOfCurrentString+1)*sizeof(char));
                     strcpy(result.sections[currentSize].entries[result.sections[currentSize].entrySize].stringArrayValue[i], &lineBuffer[currentPos]);
                     currentPos+=lengthOfCurrentString+3;
                     // TODO: FIX
@@ -793,7 +835,7 @@ Semper::load_ini_file(const char* file)
             {
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].type = S_INI_TYPE_NUMBER_ARRAY;
                 result.sections[currentSize].entries[result.sections[currentSize].entrySize].length = valueCount;
-                result.sections[currentSize].entries[result.sections[currentSize].entrySize].numberArrayValue = (double*)S_INI_ALLOC(valueCount*sizeof(double));
+                result.sections[currentSize].entries[result.sections[currentSize].entrySize].numberArrayValue = (double*)_ini_alloc(allocator, valueCount*sizeof(double));
                 char* currentNumberOffset = &lineBuffer[currentPos];
                 for(int i = 0; i < valueCount; i++)
                 {
@@ -876,9 +918,10 @@ void
 Semper::cleanup_ini_file(sIniFile* iniFile)
 {
     S_INI_ASSERT(iniFile);
+    sAllocator* allocator = iniFile->allocator;
     for(int i = 0; i < iniFile->sectionCount; i++)
         _cleanup_ini_section(&iniFile->sections[i]);
-    S_INI_FREE(iniFile->sections);
+    _ini_free(allocator, iniFile->sections);
     iniFile->sections = nullptr;
     iniFile->sectionCount = 0u;
     iniFile->_capacity = 0u;
@@ -11,13 +11,37 @@
    #include ...
    #define SEMPER_JSON_IMPLEMENTATION
    #include "sJson.h"
+
+   #define SEMPER_JSON_SIMD (with the implementation) to build a structural
+   index of the input first (AVX2 or SSE2 when the compiler targets them),
+   so the parser skips whitespace & string contents without scanning them.
+
+   #define SEMPER_JSON_NDJSON (with the implementation) to compile
+   Semper::load_ndjson & Semper::for_each_ndjson, which map a file of
+   newline-delimited JSON & parse its records on a pool of std::threads.
+
+   #define SEMPER_JSON_BENCHMARK (with the implementation) to compile
+   Semper::run_json_benchmark, which measures every load mode on generated
+   corpora (build with NDEBUG for meaningful numbers).
 */
 
 #ifndef SEMPER_JSON_H
 #define SEMPER_JSON_H
 
-#ifndef S_JSON_MAX_NAME_LENGTH
-#define S_JSON_MAX_NAME_LENGTH 256
+#ifndef S_JSON_MAX_DEPTH
+#define S_JSON_MAX_DEPTH 512 // nesting limit for objects & arrays
+#endif
+
+#ifndef S_JSON_MAX_NUMBER_LENGTH
+#define S_JSON_MAX_NUMBER_LENGTH 512 // longest number literal handed to the strtod fallback
+#endif
+
+#ifndef S_JSON_WRITE_FLUSH_SIZE
+#define S_JSON_WRITE_FLUSH_SIZE 65536 // writers with a FILE* flush once this many bytes are buffered
+#endif
+
+#ifndef S_JSON_MEMBER_INDEX_THRESHOLD
+#define S_JSON_MEMBER_INDEX_THRESHOLD 16 // objects with at least this many members get a hash index (0 disables)
 #endif
 
 #ifndef S_JSON_ASSERT
@@ -26,7 +50,9 @@
 #endif
 
 #include <stdlib.h>
+#include <stddef.h> // size_t
 #include <string.h> // memcpy, strcmp
+#include <stdio.h>  // FILE
 
 #ifndef S_JSON_ALLOC
 #define S_JSON_ALLOC(x) malloc(x)
@@ -36,19 +62,108 @@
 #define S_JSON_FREE(x) free(x)
 #endif
 
+//-----------------------------------------------------------------------------
+// [SECTION] Allocator interface (shared by Semper libraries)
+//-----------------------------------------------------------------------------
+
+#ifndef SEMPER_ALLOCATOR_INTERFACE
+#define SEMPER_ALLOCATOR_INTERFACE
+typedef void* (*sAllocatorRequestFunc)(void* userData, size_t size, size_t alignment);
+typedef void  (*sAllocatorReturnFunc) (void* userData, void* ptr);
+
+struct sAllocator
+{
+	sAllocatorRequestFunc request_memory; // returns nullptr on failure
+	sAllocatorReturnFunc  return_memory;  // may be a no-op (i.e. linear allocators)
+	void*                 userData;       // passed back to the functions above
+};
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Forward declarations and basic types
 //-----------------------------------------------------------------------------
 struct sJsonObject;
-typedef int sJsonType; // enum -> sJsonType_
+struct sJsonKey;
+struct sJsonStream;
+struct sJsonWriter;
+struct sJsonParser;
+struct sJsonFile;
+struct sJsonPath;
+struct sJsonPathSet;
+struct sJsonField;
+struct sJsonSchema;
+typedef int sJsonType;       // enum -> sJsonType_
+typedef int sJsonLoadFlags;  // enum -> sJsonLoadFlags_
+typedef int sJsonEvent;      // enum -> sJsonEvent_
+typedef int sJsonWriteFlags; // enum -> sJsonWriteFlags_
+typedef int sJsonFieldType;  // enum -> sJsonFieldType_
 
 //-----------------------------------------------------------------------------
 // [SECTION] Semper end-user API functions
 //-----------------------------------------------------------------------------
 namespace Semper
 {
-	sJsonObject* load_json(char* rawData, int size);
-	void         free_json(sJsonObject** rootObject);
+	// allocator defaults to S_JSON_ALLOC/S_JSON_FREE (free_json must be given the same allocator)
+	// returns nullptr on malformed input, the tree (objects & strings) is a single allocation
+	// from allocator, parsing scratch always comes from S_JSON_ALLOC/S_JSON_FREE
+	sJsonObject* load_json(char* rawData, size_t size, sAllocator* allocator=nullptr, sJsonLoadFlags flags=0);
+	void         free_json(sJsonObject** rootObject, sAllocator* allocator=nullptr);
+	bool         expand_json(sJsonObject* object); // decodes a lazy container one level (the accessors call this), false if malformed
+
+	// maps the file & parses it without copying it first (in situ maps copy on write, the file itself is never modified)
+	// in situ & lazy trees keep pointing into the mapping until free_json_file, otherwise it's released before returning
+	bool         load_json_file(const char* path, sJsonFile* file, sJsonLoadFlags flags=0, sAllocator* allocator=nullptr); // false if unreadable or malformed
+	void         free_json_file(sJsonFile* file);
+
+	// reusable context, scratch buffers & the DOM block are kept between documents so a steady
+	// stream of similarly sized documents parses without allocating (S_JSON_LOAD_FLAGS_LAZY isn't supported)
+	void         initialize_json_parser(sJsonParser* parser, sAllocator* allocator=nullptr);
+	sJsonObject* parse_json            (sJsonParser* parser, char* rawData, size_t size, sJsonLoadFlags flags=0); // the tree belongs to the parser, valid until the next parse_json
+	void         free_json_parser      (sJsonParser* parser);
+
+	// pull parser, input is fed in chunks of any size (tokens may straddle chunks)
+	// memory is bounded by the longest string/number plus S_JSON_MAX_DEPTH bytes
+	void       initialize_json_stream(sJsonStream* stream, sAllocator* allocator=nullptr);
+	void       feed_json_stream      (sJsonStream* stream, const char* data, int size, bool lastChunk=false); // after S_JSON_EVENT_NEED_INPUT, data must stay valid until the next one
+	sJsonEvent next_json_event       (sJsonStream* stream);
+	void       free_json_stream      (sJsonStream* stream);
+
+	// writer, output goes to writer->buffer (null terminated) or, with a file, is flushed there in blocks
+	void initialize_json_writer (sJsonWriter* writer, FILE* file=nullptr, sJsonWriteFlags flags=0, sAllocator* allocator=nullptr);
+	void flush_json_writer      (sJsonWriter* writer);
+	void free_json_writer       (sJsonWriter* writer); // flushes first
+	void write_json_begin_object(sJsonWriter* writer);
+	void write_json_end_object  (sJsonWriter* writer);
+	void write_json_begin_array (sJsonWriter* writer);
+	void write_json_end_array   (sJsonWriter* writer);
+	void write_json_key         (sJsonWriter* writer, const char* key);
+	void write_json_string      (sJsonWriter* writer, const char* value);
+	void write_json_int         (sJsonWriter* writer, long long value);
+	void write_json_double      (sJsonWriter* writer, double value); // shortest round trip, NaN & Inf -> null
+	void write_json_bool        (sJsonWriter* writer, bool value);
+	void write_json_null        (sJsonWriter* writer);
+	void write_json             (sJsonWriter* writer, const sJsonObject* object); // whole tree
+
+	// typed decoding straight from the input into a struct described by a schema (see S_JSON_FIELD),
+	// members missing from the input or null keep their values, unknown members are skipped
+	bool decode_json(const char* rawData, size_t size, const sJsonSchema& schema, void* out, sAllocator* allocator=nullptr);
+
+	// path queries compiled once into pre-hashed steps, either an RFC 6901 pointer ("/scenes/0/nodes", "" is the root,
+	// ~0 & ~1 escape '~' & '/') or a dotted path ("scenes.0.nodes" or "scenes[0].nodes")
+	bool         compile_json_path (const char* path, sJsonPath* compiled, sAllocator* allocator=nullptr); // false if malformed
+	void         free_json_path    (sJsonPath* compiled);
+	sJsonObject* query_json        (sJsonObject* root, const sJsonPath& path); // nullptr if missing (or an element of a packed array)
+
+	// many paths merged so shared prefixes are resolved once, results[i] is the value of paths[i] (nullptr if missing)
+	bool         compile_json_paths(const char* const* paths, int pathCount, sJsonPathSet* compiled, sAllocator* allocator=nullptr); // false if any is malformed
+	void         free_json_paths   (sJsonPathSet* compiled);
+	void         query_json        (sJsonObject* root, const sJsonPathSet& paths, sJsonObject** results);
+
+	// binary cache of a parsed tree, offsets instead of pointers & each distinct string stored once
+	// (only valid for the same build: object layout, pointer size & endianness are checked)
+	void*        save_json_cache(const sJsonObject* root, size_t* size, sAllocator* allocator=nullptr); // free with free_json_cache
+	void         free_json_cache(void* cache, sAllocator* allocator=nullptr);
+	sJsonObject* load_json_cache(void* data, size_t size); // fixes up pointers in place & returns the root, nullptr if invalid (data must stay alive & writable, i.e. MAP_PRIVATE)
 }
 
 //-----------------------------------------------------------------------------
@@ -66,483 +181,4663 @@ enum sJsonType_
 	S_JSON_TYPE_NULL,
 };
 
+enum sJsonEvent_
+{
+	S_JSON_EVENT_NONE,
+	S_JSON_EVENT_BEGIN_OBJECT,
+	S_JSON_EVENT_END_OBJECT,
+	S_JSON_EVENT_BEGIN_ARRAY,
+	S_JSON_EVENT_END_ARRAY,
+	S_JSON_EVENT_KEY,        // text holds the member name, its value follows
+	S_JSON_EVENT_STRING,
+	S_JSON_EVENT_NUMBER,
+	S_JSON_EVENT_BOOL,
+	S_JSON_EVENT_NULL,
+	S_JSON_EVENT_NEED_INPUT, // feed the next chunk (or the last one)
+	S_JSON_EVENT_END,        // root value complete & input exhausted
+	S_JSON_EVENT_ERROR,      // malformed input (sticky)
+};
+
+enum sJsonWriteFlags_
+{
+	S_JSON_WRITE_FLAGS_NONE   = 0,
+	S_JSON_WRITE_FLAGS_PRETTY = 1 << 0, // newlines & indentation (writer->indent spaces per level)
+};
+
+enum sJsonFieldType_
+{
+	S_JSON_FIELD_TYPE_INT,    // numbers clamp to the field's range (integer fields truncate reals)
+	S_JSON_FIELD_TYPE_UINT,
+	S_JSON_FIELD_TYPE_INT64,
+	S_JSON_FIELD_TYPE_FLOAT,
+	S_JSON_FIELD_TYPE_DOUBLE,
+	S_JSON_FIELD_TYPE_BOOL,
+	S_JSON_FIELD_TYPE_STRING, // char[N], truncated to fit & null terminated
+	S_JSON_FIELD_TYPE_OBJECT, // nested struct with its own schema
+};
+
+enum sJsonLoadFlags_
+{
+	S_JSON_LOAD_FLAGS_NONE    = 0,
+	S_JSON_LOAD_FLAGS_IN_SITU = 1 << 0, // strings are unescaped in place, names & values point into rawData (must outlive the tree)
+	S_JSON_LOAD_FLAGS_LAZY    = 1 << 1, // only the root is decoded, nested containers are skipped by bracket matching & decoded
+	                                    // on first access (rawData must outlive the tree, expanding isn't thread safe)
+	S_JSON_LOAD_FLAGS_PACK_NUMBERS = 1 << 2, // arrays holding only numbers store packed values instead of children, all long long
+	                                         // or all double (read them with as*Array/packed*, operator[](int) isn't available),
+	                                         // lazy trees pack them as they're expanded
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Structs
 //-----------------------------------------------------------------------------
 
+// member name & its hash, build once & reuse for repeated lookups (const char* converts implicitly)
+struct sJsonKey
+{
+	const char*  name;
+	int          length;
+	unsigned int hash;
+
+	inline sJsonKey(const char* member) : name(member), length((int)strlen(member)), hash(hash_name(member, (size_t)length)) {}
+	inline sJsonKey(const char* member, int memberLength) : name(member), length(memberLength), hash(hash_name(member, (size_t)memberLength)) {}
+
+	static inline unsigned int hash_name(const char* name, size_t length){ unsigned int hash = 2166136261u; for (size_t i = 0; i < length; i++) hash = (hash ^ (unsigned char)name[i]) * 16777619u; return hash;} // FNV-1a
+};
+
 struct sJsonObject
 {
 	sJsonType    type;
+	int          childCount;
 	sJsonObject* children;
-	int          childCount;	
-	char         name[S_JSON_MAX_NAME_LENGTH];
-	char*        value;
-	void*        _internal;
+	const char*  name;        // null terminated, "" for root & array elements
+	char*        value;       // null terminated, nullptr for objects & arrays (packed arrays: the elements)
+	int          nameLength;  // (bytes)
+	int          valueLength; // (bytes)
+	union
+	{
+		long long integer;  // numbers without fraction or exponent that fit in 64 bits
+		double    real;     // all other numbers
+		void*     document; // objects & arrays of lazy trees (internal)
+	}            number;      // converted once while parsing
+	bool         isInteger;   // selects number.integer (packed arrays: long long elements instead of double)
+	bool         isLazy;      // container not decoded yet (childCount is 0, value spans its raw text)
+	bool         isPacked;    // array of childCount numbers stored at value, children is nullptr
+	unsigned int memberIndex; // member hash table at (unsigned int*)children + memberIndex, 0 if none
 
-	// retrieve members
-	inline sJsonObject* getMember      (const char* member){ for (int i = 0; i < childCount; i++) if (strcmp(member, children[i].name) == 0) return &children[i]; return nullptr;}
-	inline bool         doesMemberExist(const char* member){ return getMember(member) != nullptr;}
+	// retrieve members (hashed for objects with S_JSON_MEMBER_INDEX_THRESHOLD+ members, linear otherwise)
+	inline sJsonObject* getMember      (const char* member)    { if (isLazy) Semper::expand_json(this); return memberIndex ? lookupMember(sJsonKey(member)) : findMember(member, strlen(member));}
+	inline sJsonObject* getMember      (const sJsonKey& key)   { if (isLazy) Semper::expand_json(this); return memberIndex ? lookupMember(key) : findMember(key.name, (size_t)key.length);}
+	inline bool         doesMemberExist(const sJsonKey& member){ return getMember(member) != nullptr;}
+	inline sJsonObject* findMember     (const char* member, size_t length){ for (int i = 0; i < childCount; i++) if ((size_t)children[i].nameLength == length && (length == 0 || (children[i].name[0] == member[0] && memcmp(member, children[i].name, length) == 0))) return &children[i]; return nullptr;}
+	inline sJsonObject* lookupMember   (const sJsonKey& key)
+	{
+		const unsigned int* table = (const unsigned int*)children + memberIndex; // [mask, slots...], slot = child index + 1
+		for (unsigned int slot = key.hash & table[0]; table[1 + slot] != 0u; slot = (slot + 1u) & table[0])
+		{
+			sJsonObject* member = &children[table[1 + slot] - 1u];
+			if (member->nameLength == key.length && memcmp(member->name, key.name, (size_t)key.length) == 0)
+				return member;
+		}
+		return nullptr;
+	}
 
 	// cast values
-	inline int      asInt()    { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return (int)strtod(value, nullptr);}
-	inline unsigned asUInt()   { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return (unsigned)strtod(value, nullptr);}
-	inline float    asFloat()  { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return (float)asDouble();}
-	inline double   asDouble() { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return strtod(value, nullptr);}
+	inline long long asInt64() { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return isInteger ? number.integer : (long long)number.real;}
+	inline int      asInt()    { return (int)asInt64();}
+	inline unsigned asUInt()   { return (unsigned)asInt64();}
+	inline float    asFloat()  { return (float)asDouble();}
+	inline double   asDouble() { S_JSON_ASSERT(type == S_JSON_TYPE_NUMBER); return isInteger ? (double)number.integer : number.real;}
 	inline char*    asString() { S_JSON_ASSERT(type == S_JSON_TYPE_STRING); return value;}
 	inline bool    	asBool()   { S_JSON_ASSERT(type == S_JSON_TYPE_BOOL);   return value[0] == 't';}
 	
 	// cast array values
-	inline void asIntArray   (int*      out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asInt();}
-	inline void asUIntArray  (unsigned* out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asUInt();}
-	inline void asFloatArray (float*    out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asFloat();}
-	inline void asDoubleArray(double*   out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asDouble();}
-	inline void asBoolArray  (bool*     out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asBool();}
-	inline void asStringArray(char**    out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asString();}
+	inline void asIntArray   (int*      out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); if(size > childCount) size = childCount; if(isPacked) { for(int i = 0; i < size; i++) out[i] = (int)packedInt64(i);}      else for(int i = 0; i < size; i++) out[i] = children[i].asInt();}
+	inline void asUIntArray  (unsigned* out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); if(size > childCount) size = childCount; if(isPacked) { for(int i = 0; i < size; i++) out[i] = (unsigned)packedInt64(i);} else for(int i = 0; i < size; i++) out[i] = children[i].asUInt();}
+	inline void asFloatArray (float*    out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); if(size > childCount) size = childCount; if(isPacked) { for(int i = 0; i < size; i++) out[i] = (float)packedDouble(i);}  else for(int i = 0; i < size; i++) out[i] = children[i].asFloat();}
+	inline void asDoubleArray(double*   out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); if(size > childCount) size = childCount; if(isPacked) { for(int i = 0; i < size; i++) out[i] = packedDouble(i);}         else for(int i = 0; i < size; i++) out[i] = children[i].asDouble();}
+	inline void asBoolArray  (bool*     out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); S_JSON_ASSERT(!isPacked); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asBool();}
+	inline void asStringArray(char**    out, int size) { S_JSON_ASSERT(type == S_JSON_TYPE_ARRAY); S_JSON_ASSERT(out); if(isLazy) Semper::expand_json(this); S_JSON_ASSERT(!isPacked); if(size > childCount) size = childCount; for(int i = 0; i < size; i++) out[i] = children[i].asString();}
+
+	// packed array elements
+	inline long long packedInt64 (int i) { S_JSON_ASSERT(isPacked && i < childCount); return isInteger ? ((const long long*)value)[i] : (long long)((const double*)value)[i];}
+	inline double    packedDouble(int i) { S_JSON_ASSERT(isPacked && i < childCount); return isInteger ? (double)((const long long*)value)[i] : ((const double*)value)[i];}
 
 	// retrieve and cast values
-	inline const char* getStringMember(const char* member, const char* defaultValue=0)     { auto m = getMember(member); return m==0       ? defaultValue : m->asString();}
-	inline int         getIntMember   (const char* member, int         defaultValue=0)     { auto m = getMember(member); return m==nullptr ? defaultValue : m->asInt();}
-	inline unsigned    getUIntMember  (const char* member, unsigned    defaultValue=0u)    { auto m = getMember(member); return m==nullptr ? defaultValue : m->asUInt();}
-	inline float       getFloatMember (const char* member, float       defaultValue=0.0f)  { auto m = getMember(member); return m==nullptr ? defaultValue : m->asFloat();}
-	inline double      getDoubleMember(const char* member, double      defaultValue=0.0)   { auto m = getMember(member); return m==nullptr ? defaultValue : m->asDouble();}
-	inline bool        getBoolMember  (const char* member, bool        defaultValue=false) { auto m = getMember(member); return m==nullptr ? defaultValue : m->asBool();}
+	inline const char* getStringMember(const sJsonKey& member, const char* defaultValue=0)     { auto m = getMember(member); return m==0       ? defaultValue : m->asString();}
+	inline int         getIntMember   (const sJsonKey& member, int         defaultValue=0)     { auto m = getMember(member); return m==nullptr ? defaultValue : m->asInt();}
+	inline unsigned    getUIntMember  (const sJsonKey& member, unsigned    defaultValue=0u)    { auto m = getMember(member); return m==nullptr ? defaultValue : m->asUInt();}
+	inline float       getFloatMember (const sJsonKey& member, float       defaultValue=0.0f)  { auto m = getMember(member); return m==nullptr ? defaultValue : m->asFloat();}
+	inline double      getDoubleMember(const sJsonKey& member, double      defaultValue=0.0)   { auto m = getMember(member); return m==nullptr ? defaultValue : m->asDouble();}
+	inline bool        getBoolMember  (const sJsonKey& member, bool        defaultValue=false) { auto m = getMember(member); return m==nullptr ? defaultValue : m->asBool();}
 
 	// retrieve and cast array values
-	inline void getIntArrayMember   (const char* member, int*          out, int size){ auto m = getMember(member); if(m) m->asIntArray(out, size);}
-	inline void getUIntArrayMember  (const char* member, unsigned int* out, int size){ auto m = getMember(member); if(m) m->asUIntArray(out, size);}
-	inline void getFloatArrayMember (const char* member, float*        out, int size){ auto m = getMember(member); if(m) m->asFloatArray(out, size);}
-	inline void getDoubleArrayMember(const char* member, double*       out, int size){ auto m = getMember(member); if(m) m->asDoubleArray(out, size);}
-	inline void getBoolArrayMember  (const char* member, bool*         out, int size){ auto m = getMember(member); if(m) m->asBoolArray(out, size);}
-	inline void getStringArrayMember(const char* member, char**        out, int size){ auto m = getMember(member); if(m) m->asStringArray(out, size);}
+	inline void getIntArrayMember   (const sJsonKey& member, int*          out, int size){ auto m = getMember(member); if(m) m->asIntArray(out, size);}
+	inline void getUIntArrayMember  (const sJsonKey& member, unsigned int* out, int size){ auto m = getMember(member); if(m) m->asUIntArray(out, size);}
+	inline void getFloatArrayMember (const sJsonKey& member, float*        out, int size){ auto m = getMember(member); if(m) m->asFloatArray(out, size);}
+	inline void getDoubleArrayMember(const sJsonKey& member, double*       out, int size){ auto m = getMember(member); if(m) m->asDoubleArray(out, size);}
+	inline void getBoolArrayMember  (const sJsonKey& member, bool*         out, int size){ auto m = getMember(member); if(m) m->asBoolArray(out, size);}
+	inline void getStringArrayMember(const sJsonKey& member, char**        out, int size){ auto m = getMember(member); if(m) m->asStringArray(out, size);}
+
+	inline sJsonObject& operator[](const sJsonKey& member) { auto m = getMember(member); S_JSON_ASSERT(m!=nullptr); return m==nullptr ? *this : *m;}
+	inline sJsonObject& operator[](int i)                  { if (isLazy) Semper::expand_json(this); S_JSON_ASSERT(children != nullptr); S_JSON_ASSERT(i < childCount); return children[i]; };
+};
+
+struct sJsonStream
+{
+	// current event
+	sJsonEvent  event;
+	int         depth;      // open objects & arrays
+	const char* text;       // KEY & STRING: decoded, null terminated, valid until the next call
+	int         textLength; // (bytes)
+	union
+	{
+		long long integer;
+		double    real;
+	}           number;     // NUMBER
+	bool        isInteger;  // selects number.integer
+	bool        boolean;    // BOOL
+
+	inline long long asInt64()  { S_JSON_ASSERT(event == S_JSON_EVENT_NUMBER); return isInteger ? number.integer : (long long)number.real;}
+	inline int       asInt()    { return (int)asInt64();}
+	inline unsigned  asUInt()   { return (unsigned)asInt64();}
+	inline float     asFloat()  { return (float)asDouble();}
+	inline double    asDouble() { S_JSON_ASSERT(event == S_JSON_EVENT_NUMBER); return isInteger ? (double)number.integer : number.real;}
+
+	// internal
+	sAllocator*   allocator;
+	const char*   cursor;        // current chunk
+	const char*   end;
+	bool          lastChunk;
+	int           expect;        // grammar state
+	char          partial;       // token in progress: '"' string, '0' number or literal, 0 none
+	bool          escapePending; // string chunk ended on a backslash
+	char*         token;         // token bytes gathered across chunks
+	size_t        tokenSize;
+	size_t        tokenCapacity;
+	unsigned char containers[S_JSON_MAX_DEPTH]; // '{' or '[' per open container
+};
+
+struct sJsonParser
+{
+	// internal
+	sAllocator* allocator;
+	void*       reader;         // sJsonReader_, scratch vectors & structural index
+	void*       block;          // DOM of the last document
+	size_t      blockCapacity;  // (bytes)
+	sAllocator  blockAllocator; // hands block to the layout
+};
+
+struct sJsonFile
+{
+	sJsonObject* root; // nullptr if the file couldn't be read or is malformed
+	size_t       size; // (bytes)
+
+	// internal
+	sAllocator*  _allocator;
+	void*        _mapping;  // sJsonMappedFile_ kept for in situ & lazy trees, nullptr otherwise
+};
+
+struct sJsonPathStep
+{
+	sJsonKey key;   // objects: member name (unescaped, null terminated)
+	int      index; // arrays: element, -1 if the token isn't an index
+};
+
+struct sJsonPath
+{
+	sJsonPathStep* steps;
+	int            stepCount;
+
+	// internal
+	sAllocator*    _allocator;
+};
+
+struct sJsonPathSet
+{
+	int         pathCount;
+
+	// internal
+	sJsonPath*  _paths;     // compiled one by one (the steps live here)
+	void*       _nodes;     // sJsonPathNode_, prefix tree of the steps (node 0 is the root)
+	int         _nodeCount;
+	int*        _nextPath;  // next path ending on the same node, -1 if none
+	sAllocator* _allocator;
+};
+
+struct sJsonWriter
+{
+	char*           buffer;    // pending output, null terminated
+	size_t          size;      // (bytes)
+	size_t          capacity;
+	FILE*           file;      // nullptr: everything stays in buffer
+	sJsonWriteFlags flags;
+	int             indent;    // spaces per level when pretty printing (default 4)
+	int             depth;     // open objects & arrays
+	bool            failed;    // allocation or file write failed
+
+	// internal
+	bool            needComma; // current object/array already has a value
+	bool            afterKey;  // next value belongs to the key just written
+	sAllocator*     allocator;
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Typed decoding
+//-----------------------------------------------------------------------------
+// Schemas are constant tables built from offsetof & the member types, i.e.
+//
+//   struct Camera { char name[32]; float position[3]; int flags; };
+//   static const sJsonField g_cameraFields[] = {
+//       S_JSON_FIELD(Camera, name),
+//       S_JSON_FIELD(Camera, position),
+//       S_JSON_FIELD(Camera, flags),
+//   };
+//   static const sJsonSchema g_cameraSchema = S_JSON_SCHEMA(g_cameraFields);
+//   ...
+//   Semper::decode_json(data, size, g_cameraSchema, &camera);
+
+struct sJsonField
+{
+	const char*        name;
+	int                nameLength;
+	unsigned int       hash;        // sJsonKey::hash_name
+	sJsonFieldType     type;        // element type for arrays
+	bool               isArray;
+	size_t             offset;
+	size_t             size;        // element bytes (strings: buffer bytes)
+	int                capacity;    // elements (1 unless isArray)
+	size_t             countOffset; // arrays: int receiving the element count, S_JSON_NO_COUNT if none
+	const sJsonSchema* schema;      // S_JSON_FIELD_TYPE_OBJECT
+
+	// FNV-1a in a constant expression (matches sJsonKey::hash_name)
+	static constexpr unsigned int hash_literal  (const char* name, unsigned int hash=2166136261u){ return *name ? hash_literal(name + 1, (hash ^ (unsigned char)*name) * 16777619u) : hash;}
+	static constexpr int          length_literal(const char* name)                              { return *name ? 1 + length_literal(name + 1) : 0;}
+};
+
+struct sJsonSchema
+{
+	const sJsonField* fields;
+	int               fieldCount;
+};
+
+#define S_JSON_NO_COUNT ((size_t)-1)
+
+// member type -> field description (class types are nested objects)
+template<sJsonFieldType T, size_t S>
+struct sJsonFieldTraits_
+{
+	static constexpr sJsonFieldType type     = T;
+	static constexpr bool           isArray  = false;
+	static constexpr size_t         size     = S;
+	static constexpr int            capacity = 1;
+};
+template<typename T>           struct sJsonFieldOf_                : sJsonFieldTraits_<S_JSON_FIELD_TYPE_OBJECT, sizeof(T)> {};
+template<>                     struct sJsonFieldOf_<int>           : sJsonFieldTraits_<S_JSON_FIELD_TYPE_INT,    sizeof(int)> {};
+template<>                     struct sJsonFieldOf_<unsigned>      : sJsonFieldTraits_<S_JSON_FIELD_TYPE_UINT,   sizeof(unsigned)> {};
+template<>                     struct sJsonFieldOf_<long long>     : sJsonFieldTraits_<S_JSON_FIELD_TYPE_INT64,  sizeof(long long)> {};
+template<>                     struct sJsonFieldOf_<float>         : sJsonFieldTraits_<S_JSON_FIELD_TYPE_FLOAT,  sizeof(float)> {};
+template<>                     struct sJsonFieldOf_<double>        : sJsonFieldTraits_<S_JSON_FIELD_TYPE_DOUBLE, sizeof(double)> {};
+template<>                     struct sJsonFieldOf_<bool>          : sJsonFieldTraits_<S_JSON_FIELD_TYPE_BOOL,   sizeof(bool)> {};
+template<size_t N>             struct sJsonFieldOf_<char[N]>       : sJsonFieldTraits_<S_JSON_FIELD_TYPE_STRING, N> {};
+template<typename T, size_t N> struct sJsonFieldOf_<T[N]>
+{
+	static_assert(!sJsonFieldOf_<T>::isArray, "Nested arrays aren't supported.");
+	static constexpr sJsonFieldType type     = sJsonFieldOf_<T>::type;
+	static constexpr bool           isArray  = true;
+	static constexpr size_t         size     = sJsonFieldOf_<T>::size;
+	static constexpr int            capacity = (int)N;
+};
+
+template<typename T>
+constexpr sJsonField
+_json_field(const char* name, size_t offset, const sJsonSchema* schema=nullptr, size_t countOffset=S_JSON_NO_COUNT)
+{
+	return sJsonField{ name, sJsonField::length_literal(name), sJsonField::hash_literal(name), sJsonFieldOf_<T>::type, sJsonFieldOf_<T>::isArray,
+		offset, sJsonFieldOf_<T>::size, sJsonFieldOf_<T>::capacity, countOffset, schema };
+}
+
+#define S_JSON_FIELD(type, member)                                 _json_field<decltype(type::member)>(#member, offsetof(type, member))
+#define S_JSON_ARRAY_FIELD(type, member, count)                    _json_field<decltype(type::member)>(#member, offsetof(type, member), nullptr, offsetof(type, count)) // int count receives the element count
+#define S_JSON_OBJECT_FIELD(type, member, schema)                  _json_field<decltype(type::member)>(#member, offsetof(type, member), &(schema))
+#define S_JSON_OBJECT_ARRAY_FIELD(type, member, count, schema)     _json_field<decltype(type::member)>(#member, offsetof(type, member), &(schema), offsetof(type, count))
+#define S_JSON_SCHEMA(fields)                                      sJsonSchema{ fields, (int)(sizeof(fields) / sizeof(fields[0])) }
+
+//-----------------------------------------------------------------------------
+// [SECTION] Benchmark
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_JSON_BENCHMARK)
+struct sJsonBenchmarkResult
+{
+	const char* corpus;
+	const char* mode;
+	size_t      bytes;       // corpus size
+	size_t      documents;   // loaded one after another per pass
+	size_t      failures;    // documents rejected (corpora are valid, should be 0)
+	double      seconds;     // fastest pass
+	double      mbPerSecond;
+	size_t      peakBytes;   // most memory requested & not yet returned (the input & load_json scratch, from S_JSON_ALLOC, aren't counted)
+	size_t      allocations; // requests per pass (the parser's are after its first pass)
+	double      lookupNs;    // per getMember(const char*) on the loaded trees (-1 if n/a)
+};
+
+namespace Semper
+{
+	// generated corpora (deeply nested objects, number heavy arrays, escaped strings & many small
+	// documents) loaded by each mode: DOM, in situ, lazy, packed numbers, reused parser & streaming
+	int  run_json_benchmark(sJsonBenchmarkResult* results, int maxResults, size_t corpusSize=16u << 20, int passes=5); // returns result count
+	void print_json_benchmark(const sJsonBenchmarkResult* results, int count);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] NDJSON
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_JSON_NDJSON)
+
+#ifndef S_JSON_NDJSON_BLOCK_SIZE
+#define S_JSON_NDJSON_BLOCK_SIZE 4194304 // per worker arena block (records larger than this get their own)
+#endif
 
-	inline sJsonObject& operator[](const char* member) { auto m = getMember(member); S_JSON_ASSERT(m!=nullptr); return m==nullptr ? *this : *m;}
-	inline sJsonObject& operator[](int i)              { S_JSON_ASSERT(children != nullptr); S_JSON_ASSERT(i < childCount); return children[i]; };
+// record is nullptr for a malformed line, offset is the line's byte offset in the input
+// (called concurrently from the workers, the record is only valid during the call)
+typedef void (*sJsonRecordFunc)(void* userData, sJsonObject* record, size_t offset);
+
+struct sJsonBatch
+{
+	sJsonObject** records;     // one root per non-blank line in input order, nullptr if malformed
+	size_t        recordCount;
+	size_t        errorCount;  // malformed lines (& records dropped when out of memory)
+
+	// internal
+	void*         _arenas;     // per worker blocks holding the records
+	int           _arenaCount;
 };
 
+namespace Semper
+{
+	// one JSON value per line ('\n' or '\r\n', blank lines skipped), threadCount 0 uses every core
+	// memory for the records comes from S_JSON_ALLOC (user allocators aren't assumed thread safe)
+	bool load_ndjson    (const char* path, sJsonBatch* batch, int threadCount=0); // false if the file can't be read
+	bool load_ndjson    (const char* data, size_t size, sJsonBatch* batch, int threadCount=0);
+	void free_ndjson    (sJsonBatch* batch);
+
+	// records are parsed, handed to callback & discarded (memory per worker is bounded by the largest record)
+	bool for_each_ndjson(const char* path, sJsonRecordFunc callback, void* userData, int threadCount=0);
+	bool for_each_ndjson(const char* data, size_t size, sJsonRecordFunc callback, void* userData, int threadCount=0);
+}
+#endif
+
 #endif
 
 #ifdef SEMPER_JSON_IMPLEMENTATION
 
+#include <stdint.h>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#ifdef SEMPER_JSON_SIMD
+#if defined(__AVX2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#endif
+
+static inline void*
+_json_alloc(sAllocator* allocator, size_t size)
+{
+	if(allocator) return allocator->request_memory(allocator->userData, size, 16);
+	return S_JSON_ALLOC(size);
+}
+
+static inline void
+_json_free(sAllocator* allocator, void* ptr)
+{
+	if(allocator) allocator->return_memory(allocator->userData, ptr);
+	else          S_JSON_FREE(ptr);
+}
+
+static inline int
+_json_count_leading_zeros(uint64_t value) // value != 0
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return 63 - (int)index;
+#else
+	int count = 0;
+	while ((value & (1ull << 63)) == 0) { value <<= 1; count++; }
+	return count;
+#endif
+}
+
+static inline int
+_json_count_trailing_zeros(uint64_t value) // value != 0
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (int)index;
+#else
+	int count = 0;
+	while ((value & 1u) == 0) { value >>= 1; count++; }
+	return count;
+#endif
+}
+
 // borrowed from Dear ImGui
 template<typename T>
 struct sJsonVector_
 {
-	int size     = 0u;
-	int capacity = 0u;
-	T*  data     = nullptr;
-	inline sJsonVector_() { size = capacity = 0; data = nullptr; }
-	inline sJsonVector_<T>& operator=(const sJsonVector_<T>& src) { clear(); resize(src.size); memcpy(data, src.data, (size_t)size * sizeof(T)); return *this; }
+	int         size      = 0u;
+	int         capacity  = 0u;
+	T*          data      = nullptr;
+	sAllocator* allocator = nullptr;
+	inline sJsonVector_() { size = capacity = 0; data = nullptr; allocator = nullptr; }
+	inline sJsonVector_(sAllocator* alloc) { size = capacity = 0; data = nullptr; allocator = alloc; }
+	inline sJsonVector_<T>& operator=(const sJsonVector_<T>& src) { clear(); if (resize(src.size)) memcpy(data, src.data, (size_t)size * sizeof(T)); return *this; }
 	inline bool empty() const { return size == 0; }
 	inline int  size_in_bytes() const   { return size * (int)sizeof(T); }
 	inline T&   operator[](int i) { S_JSON_ASSERT(i >= 0 && i < size); return data[i]; }
-	inline void clear() { if (data) { size = capacity = 0; S_JSON_FREE(data); data = nullptr; } }
+	inline void clear() { if (data) { size = capacity = 0; _json_free(allocator, data); data = nullptr; } }
 	inline T*   begin() { return data; }
     inline T*   end() { return data + size; }
 	inline T&   back() { S_JSON_ASSERT(size > 0); return data[size - 1]; }
-	inline void swap(sJsonVector_<T>& rhs) { int rhs_size = rhs.size; rhs.size = size; size = rhs_size; int rhs_cap = rhs.capacity; rhs.capacity = capacity; capacity = rhs_cap; T* rhs_data = rhs.data; rhs.data = data; data = rhs_data; }
+	inline void swap(sJsonVector_<T>& rhs) { int rhs_size = rhs.size; rhs.size = size; size = rhs_size; int rhs_cap = rhs.capacity; rhs.capacity = capacity; capacity = rhs_cap; T* rhs_data = rhs.data; rhs.data = data; data = rhs_data; sAllocator* rhs_alloc = rhs.allocator; rhs.allocator = allocator; allocator = rhs_alloc; }
 	inline int  _grow_capacity(int sz) { int new_capacity = capacity ? (capacity + capacity / 2) : 8; return new_capacity > sz ? new_capacity : sz; }
-	inline void resize(int new_size) { if (new_size > capacity) reserve(_grow_capacity(new_size)); size = new_size; }
-	inline void reserve(int new_capacity) { if (new_capacity <= capacity) return; T* new_data = (T*)S_JSON_ALLOC((size_t)new_capacity * sizeof(T)); if (data) { memcpy(new_data, data, (size_t)size * sizeof(T)); S_JSON_FREE(data); } data = new_data; capacity = new_capacity; }
-	inline void push_back(const T& v) { if (size == capacity) reserve(_grow_capacity(size*2)); memcpy(&data[size], &v, sizeof(v)); size++;}
+	// resize, reserve & push_back return false (leaving the vector as it was) if the allocator is out of memory
+	inline bool resize(int new_size) { if (new_size > capacity && !reserve(_grow_capacity(new_size))) return false; size = new_size; return true; }
+	inline bool reserve(int new_capacity) { if (new_capacity <= capacity) return true; T* new_data = (T*)_json_alloc(allocator, (size_t)new_capacity * sizeof(T)); if (new_data == nullptr) return false; if (data) { memcpy(new_data, data, (size_t)size * sizeof(T)); _json_free(allocator, data); } data = new_data; capacity = new_capacity; return true; }
+	inline bool push_back(const T& v) { if (size == capacity && !reserve(_grow_capacity(size*2))) return false; memcpy(&data[size], &v, sizeof(v)); size++; return true; }
 	inline void pop_back() { S_JSON_ASSERT(size > 0); size--; }
 };
 
-typedef int sJsonToken_Type;
+struct sJsonNumber_
+{
+	bool      isInteger;
+	long long integer;
+	double    real;
+};
 
-enum sJsonToken_Type_
+// scratch node recorded by the parse pass (siblings are linked, strings point into the input)
+struct sJsonNode_
 {
-	S_JSON_TOKEN_NONE,
-	S_JSON_TOKEN_LEFT_BRACE,
-	S_JSON_TOKEN_RIGHT_BRACE,
-	S_JSON_TOKEN_LEFT_BRACKET,
-	S_JSON_TOKEN_RIGHT_BRACKET,
-	S_JSON_TOKEN_COMMA,
-	S_JSON_TOKEN_COLON,
-	S_JSON_TOKEN_STRING,
-	S_JSON_TOKEN_PRIMITIVE,
-	S_JSON_TOKEN_MEMBER, // string but on the left of ":"
+	sJsonType   type;
+	int         childCount;
+	int         firstChild;  // -1 if none
+	int         nextSibling; // -1 if none
+	const char* name;
+	const char* value;
+	size_t      nameLength;
+	size_t      valueLength;
+	bool        nameEscaped;  // contains '\\' (needs decoding)
+	bool        valueEscaped; // contains '\\' (needs decoding)
+	bool        lazy;         // container skipped by bracket matching, value spans its raw text
+	bool        packed;       // numeric array, elements at reader->packed[packedStart]
+	int         packedStart;
+	sJsonNumber_ number;
 };
 
-struct sJsonToken_
+struct sJsonReader_
 {
-	sJsonToken_Type type = S_JSON_TOKEN_NONE;
-	sJsonVector_<char> value;
+	const char*              base;
+	const char*              cursor;
+	const char*              end;                // one past the last byte (an embedded '\0' is invalid)
+	sJsonVector_<sJsonNode_> nodes;              // depth-first order
+	sJsonVector_<int>        order;              // breadth-first layout queue
+	size_t                   stringBytes;        // copied strings incl. terminators (unused in situ)
+	size_t                   indexBytes;         // member hash tables
+	sJsonVector_<int>        indexed;            // slots of objects that get a member hash table
+	int                      depth;
+	bool                     shallow;            // containers below the first level are skipped (lazy loading)
+	bool                     packNumbers;        // S_JSON_LOAD_FLAGS_PACK_NUMBERS
+	sJsonVector_<uint64_t>   packed;             // elements of packed arrays (long long or double bits)
+	uint32_t*                structurals;        // offsets from base (SEMPER_JSON_SIMD only), nullptr when not indexed
+	uint32_t*                structuralBuffer;   // kept between documents
+	size_t                   structuralCapacity; // entries
+	int                      structuralCount;
+	int                      structuralNext;     // first entry not behind the cursor
 };
 
-struct sJsonStack_
+// shared by the containers of a lazy tree (number.document)
+struct sJsonDocument_
 {
-	inline void push(int id){ if (data.empty()) data.resize(2048); if (currentIndex == data.size) data.resize(data.size * 2); data[currentIndex++] = id;}
-	inline void pop()   { data[currentIndex] = -1; currentIndex--;}
-	inline int  top()   { return data[currentIndex - 1];}
-	inline bool empty() { return currentIndex == 0;}
+	sAllocator*  allocator;
+	sJsonReader_ reader;  // scratch vectors reused by every expansion
+	void*        blocks;  // expansion blocks, each starts with a pointer to the next
+	bool         inSitu;
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Structural index (SEMPER_JSON_SIMD)
+//-----------------------------------------------------------------------------
+// Optional first pass over the input, 64 bytes at a time (AVX2, SSE2 or a
+// scalar fallback). Each block becomes bitmasks (quotes, backslashes,
+// operators & whitespace), which give:
+//   * escaped characters (odd-length backslash runs, carried across blocks)
+//   * string interiors (prefix xor of the unescaped quotes)
+//   * the index: every quote, every { } [ ] : , outside strings & the first
+//     byte of every other run outside strings (numbers, literals, garbage)
+// The parser then jumps between index entries instead of scanning whitespace
+// and string contents byte by byte.
+
+#ifdef SEMPER_JSON_SIMD
 
-	int currentIndex = 0;
-	sJsonVector_<int> data;
+struct sJsonBlock_
+{
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t op;         // { } [ ] : ,
+	uint64_t whitespace;
 };
 
-static void
-_parse_for_tokens(char* rawData, sJsonVector_<sJsonToken_>& tokens)
+static inline void
+_classify_block(const char* src, sJsonBlock_* block)
+{
+	block->quote = block->backslash = block->op = block->whitespace = 0u;
+#if defined(__AVX2__)
+	for (int i = 0; i < 2; i++)
+	{
+		__m256i bytes = _mm256_loadu_si256((const __m256i*)(src + i * 32));
+		__m256i folded = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20)); // '[' -> '{', ']' -> '}'
+		__m256i op = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))));
+		__m256i whitespace = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))));
+		const int shift = i * 32;
+		block->quote      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'))) << shift;
+		block->backslash  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))) << shift;
+		block->op         |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << shift;
+		block->whitespace |= (uint64_t)(uint32_t)_mm256_movemask_epi8(whitespace) << shift;
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	for (int i = 0; i < 4; i++)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i*)(src + i * 16));
+		__m128i folded = _mm_or_si128(bytes, _mm_set1_epi8(0x20)); // '[' -> '{', ']' -> '}'
+		__m128i op = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+			_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+		__m128i whitespace = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+			_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))));
+		const int shift = i * 16;
+		block->quote      |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'))) << shift;
+		block->backslash  |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))) << shift;
+		block->op         |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << shift;
+		block->whitespace |= (uint64_t)(uint16_t)_mm_movemask_epi8(whitespace) << shift;
+	}
+#else
+	for (int i = 0; i < 64; i++)
+	{
+		const char c = src[i];
+		const uint64_t bit = 1ull << i;
+		if      (c == '"')  block->quote |= bit;
+		else if (c == '\\') block->backslash |= bit;
+		else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') block->op |= bit;
+		else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') block->whitespace |= bit;
+	}
+#endif
+}
+
+// bit i = xor of bits 0..i (1 from an opening quote up to, not including, its closing quote)
+static inline uint64_t
+_prefix_xor(uint64_t bits)
 {
-	int currentPos = 0u;
-	char currentChar = rawData[currentPos];
-	char basicTokens[] = { '{', '}', '[', ']', ':', ',' };
+#if defined(__PCLMUL__)
+	__m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)bits), _mm_set1_epi8((char)0xFF), 0);
+	return (uint64_t)_mm_cvtsi128_si64(product);
+#else
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	bits ^= bits << 8;
+	bits ^= bits << 16;
+	bits ^= bits << 32;
+	return bits;
+#endif
+}
 
-	bool inString = false;
-	sJsonVector_<char> buffer;
+// characters preceded by an odd number of backslashes, prevEscaped carries into the next block
+static inline uint64_t
+_find_escaped(uint64_t backslash, uint64_t* prevEscaped)
+{
+	const uint64_t evenBits = 0x5555555555555555ull;
+	backslash &= ~*prevEscaped; // an escaped backslash doesn't start a run
+	uint64_t followsEscape = (backslash << 1) | *prevEscaped;
+	uint64_t oddStarts = backslash & ~evenBits & ~followsEscape;
+	uint64_t evenStarts = oddStarts + backslash; // carries through each run, clearing it
+	*prevEscaped = evenStarts < oddStarts ? 1u : 0u;
+	return (evenBits ^ (evenStarts << 1)) & followsEscape;
+}
 
-	while (currentChar != 0)
+// fills reader->structurals, returns false for an unterminated string
+static bool
+_build_structural_index(sJsonReader_* reader, sAllocator* allocator)
+{
+	const char* src = reader->base;
+	const size_t size = (size_t)(reader->end - reader->base);
+	if (reader->structuralCapacity < size + 1) // at most one entry per byte
 	{
-		bool tokenFound = false;
-		if (!inString)
-		{
-			for (int i = 0; i < 6; i++)
-			{
-				if (currentChar == basicTokens[i])
-				{
-					if (!buffer.empty())
-					{
-						sJsonToken_ primitivetoken{};
-						primitivetoken.type = S_JSON_TOKEN_PRIMITIVE;
-						buffer.push_back('\0');
-						for (int i = 0; i < buffer.size; i++)
-						{
-							primitivetoken.value.push_back(buffer[i]);
-						}
-						tokens.push_back({ primitivetoken.type });
-						primitivetoken.value.swap(tokens.back().value);
-						buffer.clear();
-					}
-
-					sJsonToken_ token{};
-					if      (currentChar == '{') token.type = S_JSON_TOKEN_LEFT_BRACE;
-					else if (currentChar == '}') token.type = S_JSON_TOKEN_RIGHT_BRACE;
-					else if (currentChar == '[') token.type = S_JSON_TOKEN_LEFT_BRACKET;
-					else if (currentChar == ']') token.type = S_JSON_TOKEN_RIGHT_BRACKET;
-					else if (currentChar == ',') token.type = S_JSON_TOKEN_COMMA;
-					else if (currentChar == ':') token.type = S_JSON_TOKEN_COLON;
-
-					token.value.push_back(currentChar);
-					token.value.push_back(0);
-					tokens.push_back({ token.type });
-					token.value.swap(tokens.back().value);
-					tokenFound = true;
-					break;
-				}
-			}
-		}
+		if (reader->structuralBuffer)
+			_json_free(allocator, reader->structuralBuffer);
+		reader->structuralBuffer = (uint32_t*)_json_alloc(allocator, (size + 1) * sizeof(uint32_t));
+		reader->structuralCapacity = reader->structuralBuffer ? size + 1 : 0u;
+		if (reader->structuralBuffer == nullptr)
+			return false;
+	}
+	uint32_t* out = reader->structuralBuffer;
+	reader->structurals = out;
 
-		// strings
-		if (!tokenFound)
+	uint64_t prevEscaped = 0u;
+	uint64_t prevInString = 0u; // all ones while inside a string
+	uint64_t prevScalar = 0u;
+	for (size_t offset = 0u; offset < size; offset += 64u)
+	{
+		sJsonBlock_ block;
+		if (size - offset >= 64u)
+			_classify_block(src + offset, &block);
+		else
 		{
-			if (currentChar == '"')
-			{
-				if (inString)
-				{
-					sJsonToken_ token{};
-					buffer.push_back('\0');
-					for (int i = 0; i < buffer.size; i++)
-					{
-						token.value.push_back(buffer[i]);
-					}
-
-
-					if (rawData[currentPos + 1] == ':')
-						token.type = S_JSON_TOKEN_MEMBER;
-					else
-						token.type = S_JSON_TOKEN_STRING;
-					tokens.push_back({token.type});
-					token.value.swap(tokens.back().value);
-					tokenFound = true;
-					inString = false;
-					buffer.clear();
-				}
-				else
-				{
-					inString = true;
-					buffer.clear();
-					tokenFound = true;
-				}
-			}
-			else if (inString)
-			{
-				tokenFound = true;
-				buffer.push_back(currentChar);
-			}
+			char padded[64];
+			memset(padded, ' ', sizeof(padded));
+			memcpy(padded, src + offset, size - offset);
+			_classify_block(padded, &block);
 		}
 
-		// primitives
-		if (!tokenFound)
+		uint64_t quote = block.quote & ~_find_escaped(block.backslash, &prevEscaped);
+		uint64_t inString = _prefix_xor(quote) ^ prevInString;
+		prevInString = (uint64_t)((int64_t)inString >> 63);
+
+		uint64_t scalar = ~(block.op | block.whitespace | quote);
+		uint64_t scalarStarts = scalar & ~((scalar << 1) | prevScalar);
+		prevScalar = scalar >> 63;
+
+		uint64_t structurals = ((block.op | scalarStarts) & ~inString) | quote;
+		while (structurals)
 		{
-			buffer.push_back(currentChar);
+			*out++ = (uint32_t)(offset + (size_t)_json_count_trailing_zeros(structurals));
+			structurals &= structurals - 1u;
 		}
-
-		currentPos++;
-		currentChar = rawData[currentPos];
 	}
+	reader->structuralCount = (int)(out - reader->structurals);
 
+	if (prevInString)
+		return false;
+	return true;
 }
 
-static void
-_remove_whitespace(char* rawData, char* spacesRemoved, size_t size)
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] Strings
+//-----------------------------------------------------------------------------
+// String bodies are validated while parsing (escapes, no raw control bytes,
+// well formed UTF-8) so decoding during layout can't fail. Plain ASCII is
+// skipped a block at a time (32 bytes with AVX2, 16 with SSE2 under
+// SEMPER_JSON_SIMD, 8 with integer tricks otherwise) & only quotes,
+// backslashes, control bytes & non-ASCII lead bytes are looked at one by one.
+
+#if defined(SEMPER_JSON_SIMD) && defined(__AVX2__)
+#define S_JSON_STRING_BLOCK_ 32
+#elif defined(SEMPER_JSON_SIMD) && defined(__SSE2__)
+#define S_JSON_STRING_BLOCK_ 16
+#else
+#define S_JSON_STRING_BLOCK_ 8
+#endif
+
+// leading bytes of the block at p that need no attention (S_JSON_STRING_BLOCK_ if none do)
+static inline int
+_plain_prefix(const char* p)
+{
+#if defined(SEMPER_JSON_SIMD) && defined(__AVX2__)
+	__m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+	__m256i special = _mm256_or_si256(
+		_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))),
+		_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), bytes)); // signed: control bytes & everything >= 0x80
+	const uint32_t mask = (uint32_t)_mm256_movemask_epi8(special);
+	return mask ? _json_count_trailing_zeros(mask) : 32;
+#elif defined(SEMPER_JSON_SIMD) && defined(__SSE2__)
+	__m128i bytes = _mm_loadu_si128((const __m128i*)p);
+	__m128i special = _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))),
+		_mm_cmplt_epi8(bytes, _mm_set1_epi8(0x20))); // signed: control bytes & everything >= 0x80
+	const uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+	return mask ? _json_count_trailing_zeros(mask) : 16;
+#else
+	const uint64_t ones = 0x0101010101010101ull;
+	const uint64_t high = 0x8080808080808080ull;
+	uint64_t chunk;
+	memcpy(&chunk, p, 8);
+	const uint64_t quote = chunk ^ (ones * '"');
+	const uint64_t backslash = chunk ^ (ones * '\\');
+	const uint64_t mask = (((chunk - ones * 0x20) & ~chunk) | ((quote - ones) & ~quote) | ((backslash - ones) & ~backslash) | chunk) & high; // exact up to the first hit
+	if (mask == 0u)
+		return 8;
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	return _json_count_trailing_zeros(mask) >> 3;
+#else
+	return 0;
+#endif
+#endif
+}
+
+static int
+_hex_digit(char c)
+{
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+static bool
+_parse_hex4(const char* src, unsigned int* codepoint)
 {
-	size_t currentPos = 0;
-	size_t newCursor = 0;
-	bool insideString = false;
-	char currentChar = rawData[currentPos];
-	while (currentChar != 0)
+	*codepoint = 0u;
+	for (int i = 0; i < 4; i++)
 	{
-		if (currentChar == '"' && insideString)
-			insideString = false;
-		else if (currentChar == '"')
-			insideString = true;
+		int digit = _hex_digit(src[i]);
+		if (digit < 0)
+			return false;
+		*codepoint = (*codepoint << 4) | (unsigned int)digit;
+	}
+	return true;
+}
+
+// bytes in the well formed UTF-8 sequence at p (RFC 3629: no overlongs, surrogates or > U+10FFFF), 0 if malformed
+static inline int
+_utf8_sequence_length(const unsigned char* p, const unsigned char* end)
+{
+	int length;
+	unsigned char low = 0x80, high = 0xBF; // range of the second byte
+	if (p[0] >= 0xC2 && p[0] <= 0xDF)      length = 2;
+	else if (p[0] >= 0xE0 && p[0] <= 0xEF) { length = 3; if (p[0] == 0xE0) low = 0xA0; else if (p[0] == 0xED) high = 0x9F;}
+	else if (p[0] >= 0xF0 && p[0] <= 0xF4) { length = 4; if (p[0] == 0xF0) low = 0x90; else if (p[0] == 0xF4) high = 0x8F;}
+	else                                    return 0;
+	if (end - p < length || p[1] < low || p[1] > high)
+		return 0;
+	for (int i = 2; i < length; i++)
+		if ((p[i] & 0xC0) != 0x80)
+			return 0;
+	return length;
+}
 
-		if (currentChar == ' ' || currentChar == '\n'
-			|| currentChar == '\r' || currentChar == '\t')
+// validates a string body from p, returns the closing quote, end if there is none (nullptr if malformed)
+static const char*
+_scan_string(const char* p, const char* end, bool* escaped)
+{
+	*escaped = false;
+	while (p < end)
+	{
+		while (end - p >= S_JSON_STRING_BLOCK_)
 		{
-			if (insideString)
-			{
-				spacesRemoved[newCursor] = rawData[currentPos];
-				newCursor++;
-			}
-			currentPos++;
+			const int plain = _plain_prefix(p);
+			p += plain;
+			if (plain < S_JSON_STRING_BLOCK_)
+				break;
 		}
-		else
+		if (p == end)
+			break;
+
+		const unsigned char c = (unsigned char)*p;
+		if (c == '"')
+			return p;
+		if (c == '\\')
 		{
-			spacesRemoved[newCursor] = rawData[currentPos];
-			currentPos++;
-			newCursor++;
+			*escaped = true;
+			unsigned int codepoint;
+			const char e = p + 1 < end ? p[1] : '\0';
+			if (e == 'u' && end - p >= 6 && _parse_hex4(p + 2, &codepoint))
+				p += 6;
+			else if (e == '"' || e == '\\' || e == '/' || e == 'b' || e == 'f' || e == 'n' || e == 'r' || e == 't')
+				p += 2;
+			else
+				return nullptr;
 		}
-
-		if (currentPos >= size || newCursor >= size)
+		else if (c >= 0x80)
 		{
-			spacesRemoved[newCursor] = 0;
-			break;
+			const int length = _utf8_sequence_length((const unsigned char*)p, (const unsigned char*)end);
+			if (length == 0)
+				return nullptr;
+			p += length;
 		}
-		currentChar = rawData[currentPos];
+		else if (c < 0x20)
+			return nullptr;
+		else
+			p++;
 	}
+	return end;
 }
 
-static void
-_update_children_pointers(sJsonObject* object, sJsonVector_<sJsonObject*>* objects)
+static inline char
+_peek(sJsonReader_* reader)
 {
-	S_JSON_ASSERT(object->_internal);
+	return reader->cursor < reader->end ? *reader->cursor : '\0';
+}
 
-	if((*(sJsonVector_<int>*)(object->_internal)).empty())
+static inline void
+_skip_whitespace(sJsonReader_* reader)
+{
+#ifdef SEMPER_JSON_SIMD
+	if (reader->structurals) // jump to the next indexed byte
 	{
-		S_JSON_FREE(object->_internal);
-		object->_internal = nullptr;
+		const uint32_t offset = (uint32_t)(reader->cursor - reader->base);
+		while (reader->structuralNext < reader->structuralCount && reader->structurals[reader->structuralNext] < offset)
+			reader->structuralNext++;
+		const char c = _peek(reader);
+		if (c != ' ' && c != '\n' && c != '\r' && c != '\t') // only whitespace is skipped (the rest of a run may be garbage)
+			return;
+		reader->cursor = reader->structuralNext < reader->structuralCount ? reader->base + reader->structurals[reader->structuralNext] : reader->end;
 		return;
 	}
-
-	object->childCount = (*(sJsonVector_<int>*)(object->_internal)).size;
-	object->children = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject)*object->childCount);
-	for(int i = 0; i < (*(sJsonVector_<int>*)(object->_internal)).size; i++)
+#endif
+	while (reader->cursor < reader->end)
 	{
-		object->children[i] = *(*objects)[(*(sJsonVector_<int>*)(object->_internal))[i]];
-		_update_children_pointers(&object->children[i], objects);
+		char c = *reader->cursor;
+		if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+			break;
+		reader->cursor++;
 	}
+}
 
-	S_JSON_FREE(object->_internal);
-	object->_internal = nullptr;
+static inline int
+_push_node(sJsonReader_* reader)
+{
+	sJsonNode_ node{};
+	node.firstChild = -1;
+	node.nextSibling = -1;
+	if (!reader->nodes.push_back(node))
+		return -1; // out of memory
+	return reader->nodes.size - 1;
 }
 
-sJsonObject*
-Semper::load_json(char* rawData, int size)
+// cursor on opening quote, leaves cursor after closing quote (escapes are validated here & decoded during layout)
+static bool
+_parse_string(sJsonReader_* reader, const char** start, size_t* length, bool* escaped)
 {
-	sJsonStack_ parentIDStack;
-	sJsonVector_<sJsonObject*> objectArray;
+	*start = reader->cursor + 1;
+	const char* end = reader->end;
+#ifdef SEMPER_JSON_SIMD
+	if (reader->structurals) // cursor is on an indexed quote, the closing quote is the next entry
+	{
+		S_JSON_ASSERT(reader->structurals[reader->structuralNext] == (uint32_t)(reader->cursor - reader->base));
+		end = reader->base + reader->structurals[reader->structuralNext + 1];
+		reader->structuralNext += 2;
+	}
+#endif
+	const char* closing = _scan_string(*start, end, escaped);
+	if (closing == nullptr)
+		return false;
+	if (closing == reader->end || *closing != '"')
+		return false;
+	*length = (size_t)(closing - *start);
+	reader->cursor = closing + 1;
+	return true;
+}
 
-	char* spacesRemoved = (char*)S_JSON_ALLOC(sizeof(char)*size);
-	_remove_whitespace(rawData, spacesRemoved, size);
+//-----------------------------------------------------------------------------
+// [SECTION] Number conversion
+//-----------------------------------------------------------------------------
+// Numbers are converted once while parsing. Integers that fit in 64 bits are
+// stored exactly; everything else becomes the correctly rounded double:
+//   1. Clinger's fast path (mantissa <= 2^53, |exponent| <= 22) is exact with
+//      a single multiplication or division.
+//   2. Eisel-Lemire multiplies the mantissa by a truncated 128-bit power of
+//      five and only needs the low product when the result is ambiguous.
+//   3. Mantissas with more than 19 digits & results that overflow fall back to
+//      strtod.
 
-	sJsonVector_<sJsonToken_>* tokens =  (sJsonVector_<sJsonToken_>*)S_JSON_ALLOC(sizeof(sJsonVector_<sJsonToken_>));
-	new (tokens) sJsonVector_<sJsonToken_>();
-	_parse_for_tokens(spacesRemoved, *tokens);
+// 128-bit truncations of 5^q for q in [-342, 340], most significant bit set
+// (number parsing needs q <= 308, shortest float formatting up to 324)
+static const uint64_t g_semperJsonPowersOfFive[683][2] = {
+	{0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL}, {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+	{0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL}, {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+	{0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL}, {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+	{0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL}, {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+	{0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL}, {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+	{0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL}, {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+	{0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL}, {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+	{0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL}, {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+	{0x84A57695FE98746DULL, 0x014BB630F7604B57ULL}, {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+	{0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL}, {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+	{0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL}, {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+	{0xFD00B897478238D0ULL, 0x8920B098955522B4ULL}, {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+	{0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL}, {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+	{0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL}, {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+	{0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL}, {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+	{0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL}, {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+	{0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL}, {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+	{0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL}, {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+	{0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL}, {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+	{0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL}, {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+	{0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL}, {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+	{0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL}, {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+	{0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL}, {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+	{0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL}, {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+	{0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL}, {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+	{0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+	{0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+	{0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+	{0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+	{0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+	{0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+	{0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+	{0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+	{0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+	{0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+	{0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+	{0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+	{0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+	{0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+	{0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+	{0xC987434744AC874EULL, 0xA327FFB266B56220ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+	{0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+	{0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+	{0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+	{0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+	{0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+	{0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+	{0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+	{0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+	{0xAECC49914078536DULL, 0x58FAE9F773886E18ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+	{0x888F99797A5E012DULL, 0x6D8406C952429603ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+	{0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+	{0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+	{0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+	{0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+	{0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+	{0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+	{0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+	{0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+	{0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+	{0xB913179899F68584ULL, 0x28E2557B59846E3FULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+	{0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+	{0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+	{0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+	{0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+	{0xD77485CB25823AC7ULL, 0x7D633293366B828BULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+	{0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+	{0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+	{0xCD795BE870516656ULL, 0x67902E276C921F8BULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+	{0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+	{0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+	{0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+	{0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+	{0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+	{0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+	{0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+	{0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+	{0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+	{0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+	{0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+	{0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL}, {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+	{0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+	{0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+	{0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+	{0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+	{0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+	{0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+	{0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+	{0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+	{0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+	{0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+	{0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+	{0x8C974F7383725573ULL, 0x1E414218C73A13FBULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+	{0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+	{0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+	{0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+	{0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+	{0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+	{0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+	{0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+	{0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+	{0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+	{0xBE89523386091465ULL, 0xF6BBB397F1135823ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+	{0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+	{0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+	{0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+	{0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+	{0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+	{0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+	{0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+	{0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+	{0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+	{0x811CCC668829B887ULL, 0x0806357D5A3F525FULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+	{0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+	{0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+	{0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+	{0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+	{0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+	{0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+	{0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+	{0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+	{0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+	{0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+	{0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+	{0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+	{0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+	{0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+	{0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+	{0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+	{0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+	{0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+	{0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+	{0xED246723473E3813ULL, 0x290123E9AAB23B68ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+	{0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+	{0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+	{0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+	{0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+	{0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+	{0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+	{0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+	{0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+	{0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+	{0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+	{0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+	{0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+	{0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+	{0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+	{0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+	{0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+	{0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+	{0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+	{0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+	{0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+	{0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+	{0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+	{0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+	{0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+	{0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL},
+	{0xC612062576589DDAULL, 0x95364AFE032A819EULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL},
+	{0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL},
+	{0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL},
+	{0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL},
+	{0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL},
+	{0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL},
+	{0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL},
+	{0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL},
+	{0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953031ULL},
+	{0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL},
+	{0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL},
+	{0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL},
+	{0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL},
+	{0x8000000000000000ULL, 0x0000000000000000ULL}, {0xA000000000000000ULL, 0x0000000000000000ULL},
+	{0xC800000000000000ULL, 0x0000000000000000ULL}, {0xFA00000000000000ULL, 0x0000000000000000ULL},
+	{0x9C40000000000000ULL, 0x0000000000000000ULL}, {0xC350000000000000ULL, 0x0000000000000000ULL},
+	{0xF424000000000000ULL, 0x0000000000000000ULL}, {0x9896800000000000ULL, 0x0000000000000000ULL},
+	{0xBEBC200000000000ULL, 0x0000000000000000ULL}, {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+	{0x9502F90000000000ULL, 0x0000000000000000ULL}, {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+	{0xE8D4A51000000000ULL, 0x0000000000000000ULL}, {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+	{0xB5E620F480000000ULL, 0x0000000000000000ULL}, {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+	{0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+	{0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+	{0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+	{0x878678326EAC9000ULL, 0x0000000000000000ULL}, {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+	{0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, {0x84595161401484A0ULL, 0x0000000000000000ULL},
+	{0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+	{0x813F3978F8940984ULL, 0x4000000000000000ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+	{0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+	{0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+	{0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+	{0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+	{0x96769950B50D88F4ULL, 0x1314448000000000ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+	{0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+	{0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+	{0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+	{0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+	{0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+	{0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+	{0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+	{0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+	{0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+	{0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+	{0x9F4F2726179A2245ULL, 0x01D762422C946590ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+	{0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+	{0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+	{0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+	{0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+	{0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+	{0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+	{0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+	{0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+	{0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+	{0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+	{0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+	{0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+	{0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+	{0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+	{0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+	{0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+	{0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+	{0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+	{0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+	{0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+	{0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+	{0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+	{0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+	{0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+	{0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+	{0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+	{0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+	{0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+	{0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+	{0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+	{0x9AE757596946075FULL, 0x3375788DE9B06958ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+	{0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+	{0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+	{0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+	{0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+	{0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+	{0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+	{0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+	{0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+	{0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+	{0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+	{0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+	{0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+	{0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+	{0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+	{0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+	{0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+	{0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+	{0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+	{0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+	{0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+	{0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+	{0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+	{0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+	{0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+	{0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+	{0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+	{0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+	{0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+	{0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+	{0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+	{0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+	{0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+	{0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+	{0x8FA475791A569D10ULL, 0xF96E017D694487BCULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+	{0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+	{0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+	{0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+	{0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+	{0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+	{0x82A45B450226B39CULL, 0xECC0024661173473ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+	{0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+	{0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+	{0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+	{0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+	{0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+	{0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+	{0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+	{0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+	{0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+	{0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+	{0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+	{0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+	{0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+	{0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+	{0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+	{0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+	{0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+	{0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+	{0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+	{0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+	{0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+	{0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+	{0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+	{0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+	{0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+	{0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+	{0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+	{0x8533285C936B35DEULL, 0xD53A88958F87275FULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+	{0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+	{0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+	{0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+	{0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+	{0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+	{0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+	{0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+	{0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+	{0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+	{0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+	{0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+	{0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+	{0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+	{0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+	{0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+	{0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+	{0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+	{0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+	{0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+	{0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+	{0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+	{0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+	{0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+	{0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+	{0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL}, {0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL},
+	{0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL}, {0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL},
+	{0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL}, {0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL},
+	{0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL}, {0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL},
+	{0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL}, {0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL},
+	{0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL}, {0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL},
+	{0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL}, {0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL},
+	{0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL}, {0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL},
+	{0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL}, {0xC5A05277621BE293ULL, 0xC7098B7305241885ULL},
+	{0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL}, {0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL},
+	{0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL}, {0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL},
+	{0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL}, {0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL},
+	{0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL}, {0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL},
+	{0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL}, {0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL},
+	{0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL}, {0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL},
+	{0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL}, {0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL},
+	{0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL},
+};
 
-	sJsonObject *rootObject = (sJsonObject *)S_JSON_ALLOC(sizeof(sJsonObject));
-	rootObject->type = S_JSON_TYPE_OBJECT;
-	rootObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-	new (rootObject->_internal) sJsonVector_<int>();
-	
-	objectArray.push_back(rootObject);
-	parentIDStack.push(0);
+static const double g_semperJsonExactPowersOfTen[23] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-	int i = 0;
-	bool waitingOnValue = true;
-	while (true)
-	{
+static inline void
+_multiply_128(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = (unsigned __int128)a * b;
+	*high = (uint64_t)(product >> 64);
+	*low = (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	*low = _umul128(a, b, high);
+#else
+	uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+	uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+	uint64_t lowLow = aLow * bLow;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFu) + lowHigh;
+	*high = aHigh * bHigh + (highLow >> 32) + (middle >> 32);
+	*low = (middle << 32) | (lowLow & 0xFFFFFFFFu);
+#endif
+}
 
-		if (i >= tokens->size)
-			break;
+// mantissa: nonzero, at most 19 digits; returns false if the result is out of range
+static bool
+_eisel_lemire(uint64_t mantissa, int exponent10, bool negative, double* out)
+{
+	if (exponent10 < -342 || exponent10 > 308)
+		return false;
 
-		sJsonObject* parent = objectArray[parentIDStack.top()];
+	int leadingZeros = _json_count_leading_zeros(mantissa);
+	mantissa <<= leadingZeros;
 
-		switch ((*tokens)[i].type)
-		{
+	const uint64_t* power = g_semperJsonPowersOfFive[exponent10 + 342];
+	uint64_t upper = 0u;
+	uint64_t lower = 0u;
+	_multiply_128(mantissa, power[0], &upper, &lower);
+	if ((upper & 0x1FF) == 0x1FF) // truncated power might matter, include the low half
+	{
+		uint64_t secondUpper = 0u;
+		uint64_t secondLower = 0u;
+		_multiply_128(mantissa, power[1], &secondUpper, &secondLower);
+		lower += secondUpper;
+		if (secondUpper > lower)
+			upper++;
+	}
 
-		case S_JSON_TOKEN_LEFT_BRACE:
-		{
+	uint64_t upperBit = upper >> 63;
+	uint64_t bits = upper >> (upperBit + 9);
+	leadingZeros += (int)(1 ^ upperBit);
 
-			if(waitingOnValue)
-			{
-				waitingOnValue = false; // object was created in S_JSON_TOKEN_MEMBER case below.
-			}
-			else
-			{
-				sJsonObject *newObject = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject));
-				newObject->type = S_JSON_TYPE_OBJECT;
-				newObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-				new (newObject->_internal) sJsonVector_<int>();
-				objectArray.push_back(newObject);
-				parentIDStack.push(objectArray.size-1);
-				(*(sJsonVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);
-			}
-			i++;
-			break;
+	// floor(log2(10^q)) + bias
+	int64_t exponent2 = ((((int64_t)152170 + 65536) * exponent10) >> 16) + 1024 + 63 - leadingZeros;
+	if (exponent2 <= 0) // subnormal
+	{
+		if (-exponent2 + 1 >= 64)
+			bits = 0u;
+		else
+		{
+			bits >>= -exponent2 + 1;
+			bits += bits & 1;
+			bits >>= 1;
+		}
+		exponent2 = bits < (1ull << 52) ? 0 : 1;
+	}
+	else
+	{
+		// exact halfway cases round to even
+		if (lower <= 1 && exponent10 >= -4 && exponent10 <= 23 && (bits & 3) == 1 && (bits << (upperBit + 64 - 52 - 3)) == upper)
+			bits &= ~(uint64_t)1;
+		bits += bits & 1;
+		bits >>= 1;
+		if (bits >= (1ull << 53))
+		{
+			bits = 1ull << 52;
+			exponent2++;
+		}
+		bits &= ~(1ull << 52);
+		if (exponent2 > 2046)
+			return false;
+	}
+
+	bits |= (uint64_t)exponent2 << 52;
+	bits |= (uint64_t)negative << 63;
+	memcpy(out, &bits, sizeof(double));
+	return true;
+}
+
+// validates & converts the JSON number starting at start, returns one past its end (nullptr if invalid)
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define S_JSON_SWAR_DIGITS_ // eight digits at a time, needs little endian loads
+#endif
+
+#ifdef S_JSON_SWAR_DIGITS_
+static inline bool
+_load_eight_digits(const char* p, const char* end, uint64_t* chunk)
+{
+	if (end - p < 8)
+		return false;
+	memcpy(chunk, p, 8);
+	return (((*chunk & 0xF0F0F0F0F0F0F0F0ull) | (((*chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+// combines digit pairs, then quads, then the two halves with multiplies
+static inline uint64_t
+_eight_digits_value(uint64_t chunk)
+{
+	chunk -= 0x3030303030303030ull;
+	chunk = chunk * 10u + (chunk >> 8);
+	return (((chunk & 0x000000FF000000FFull) * (100u + (1000000ull << 32))) + (((chunk >> 16) & 0x000000FF000000FFull) * (1u + (10000ull << 32)))) >> 32;
+}
+#endif
+
+static const char*
+_parse_number(const char* start, const char* end, sJsonNumber_* number)
+{
+	const char* p = start;
+
+	bool negative = p < end && *p == '-';
+	if (negative)
+		p++;
+	if (p == end || *p < '0' || *p > '9')
+		return nullptr;
+
+	uint64_t mantissa = 0u;
+	int digits = 0;         // significant digits in mantissa
+	int exponent10 = 0;
+	bool truncated = false; // more than 19 significant digits
+	bool isInteger = true;
+
+	if (*p == '0')
+		p++;
+	else
+	{
+#ifdef S_JSON_SWAR_DIGITS_
+		uint64_t chunk = 0u;
+		for (; digits <= 11 && _load_eight_digits(p, end, &chunk); p += 8, digits += 8)
+			mantissa = mantissa * 100000000u + _eight_digits_value(chunk);
+#endif
+		for (; p < end && *p >= '0' && *p <= '9'; p++)
+		{
+			if (digits < 19) { mantissa = mantissa * 10 + (uint64_t)(*p - '0'); digits++;}
+			else             { exponent10++; truncated = true;}
 		}
+	}
 
-		case S_JSON_TOKEN_LEFT_BRACKET:
+	if (p < end && *p == '.')
+	{
+		isInteger = false;
+		p++;
+		if (p == end || *p < '0' || *p > '9')
+			return nullptr;
+		for (; mantissa == 0u && p < end && *p == '0'; p++)
+			exponent10--; // leading zeros aren't significant
+#ifdef S_JSON_SWAR_DIGITS_
+		uint64_t chunk = 0u;
+		for (; digits <= 11 && _load_eight_digits(p, end, &chunk); p += 8, digits += 8, exponent10 -= 8)
+			mantissa = mantissa * 100000000u + _eight_digits_value(chunk);
+#endif
+		for (; p < end && *p >= '0' && *p <= '9'; p++)
 		{
+			if (digits < 19) { mantissa = mantissa * 10 + (uint64_t)(*p - '0'); digits++; exponent10--;}
+			else             truncated = true;
+		}
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		isInteger = false;
+		p++;
+		bool negativeExponent = p < end && *p == '-';
+		if (p < end && (*p == '-' || *p == '+'))
+			p++;
+		if (p == end || *p < '0' || *p > '9')
+			return nullptr;
+		int exponent = 0;
+		for (; p < end && *p >= '0' && *p <= '9'; p++)
+			if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+		exponent10 += negativeExponent ? -exponent : exponent;
+	}
+
+	if (isInteger && !truncated && mantissa <= (negative ? (1ull << 63) : (1ull << 63) - 1u))
+	{
+		number->isInteger = true;
+		number->integer = negative ? (long long)(0u - mantissa) : (long long)mantissa;
+		return p;
+	}
+
+	number->isInteger = false;
+	double result = 0.0;
+	if (!truncated && mantissa == 0u)
+		result = 0.0;
+	else if (!truncated && mantissa <= (1ull << 53) && exponent10 >= -22 && exponent10 <= 22)
+		result = exponent10 < 0 ? (double)mantissa / g_semperJsonExactPowersOfTen[-exponent10] : (double)mantissa * g_semperJsonExactPowersOfTen[exponent10];
+	else if (!truncated && exponent10 < -342)
+		result = 0.0;
+	else if (truncated || !_eisel_lemire(mantissa, exponent10, false, &result))
+	{
+		char buffer[S_JSON_MAX_NUMBER_LENGTH + 1];
+		size_t length = (size_t)(p - start);
+		if (length > S_JSON_MAX_NUMBER_LENGTH)
+			return nullptr;
+		memcpy(buffer, start, length);
+		buffer[length] = 0;
+		number->real = strtod(buffer, nullptr);
+		return p;
+	}
+	number->real = negative ? -result : result;
+	return p;
+}
+
+// cursor on a literal or number, leaves cursor after it (must be followed by a delimiter)
+static bool
+_scan_primitive(sJsonReader_* reader, sJsonType* primitiveType, sJsonNumber_* number)
+{
+	const char* start = reader->cursor;
+	char c = *start;
+	sJsonType type = S_JSON_TYPE_NUMBER;
+	if (c == 't' || c == 'f' || c == 'n')
+	{
+		const char* literal = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+		size_t length = strlen(literal);
+		if ((size_t)(reader->end - start) < length || memcmp(start, literal, length) != 0)
+			return false;
+		type = c == 'n' ? S_JSON_TYPE_NULL : S_JSON_TYPE_BOOL;
+		reader->cursor += length;
+	}
+	else
+	{
+		if (c != '-' && (c < '0' || c > '9'))
+			return false;
+		reader->cursor = _parse_number(start, reader->end, number);
+		if (reader->cursor == nullptr)
+			return false;
+	}
+	c = _peek(reader);
+	if (reader->cursor < reader->end && c != ',' && c != ']' && c != '}' && c != ' ' && c != '\n' && c != '\r' && c != '\t')
+		return false;
+	*primitiveType = type;
+	return true;
+}
+
+static bool
+_parse_primitive(sJsonReader_* reader, int nodeIndex)
+{
+	const char* start = reader->cursor;
+	sJsonType type = S_JSON_TYPE_NONE;
+	if (!_scan_primitive(reader, &type, &reader->nodes[nodeIndex].number))
+		return false;
+	sJsonNode_& node = reader->nodes[nodeIndex];
+	node.type = type;
+	node.value = start;
+	node.valueLength = (size_t)(reader->cursor - start);
+	reader->stringBytes += node.valueLength + 1;
+	return true;
+}
+
+static bool _parse_value(sJsonReader_* reader, int nodeIndex);
 
-			if(waitingOnValue)
+// cursor on an opening bracket, leaves cursor after its match (only brackets &
+// string boundaries are checked, the rest is validated once the span is expanded)
+static bool
+_skip_container(sJsonReader_* reader)
+{
+	char closing[S_JSON_MAX_DEPTH];
+	int depth = 0;
+	const char* p = reader->cursor;
+	while (p < reader->end)
+	{
+		const char c = *p++;
+		if (c == '"')
+		{
+			while (true) // closing quote is the first one not preceded by an odd run of backslashes
 			{
-				waitingOnValue = false; // object was created in S_JSON_TOKEN_MEMBER case below.
+				p = (const char*)memchr(p, '"', (size_t)(reader->end - p));
+				if (p == nullptr)
+					return false;
+				const char* backslash = p;
+				while (backslash[-1] == '\\')
+					backslash--;
+				p++;
+				if (((p - 1 - backslash) & 1) == 0)
+					break;
 			}
-			else
+		}
+		else if (c == '{' || c == '[')
+		{
+			if (reader->depth + depth >= S_JSON_MAX_DEPTH)
+				return false;
+			closing[depth++] = c == '{' ? '}' : ']';
+		}
+		else if (c == '}' || c == ']')
+		{
+			if (depth == 0 || closing[--depth] != c)
+				return false;
+			if (depth == 0)
 			{
-				sJsonObject *newObject = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject));
-				newObject->type = S_JSON_TYPE_ARRAY;
-				newObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-				new (newObject->_internal) sJsonVector_<int>();
-				objectArray.push_back(newObject);
-				parentIDStack.push(objectArray.size-1);
-				(*(sJsonVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);	
+				reader->cursor = p;
+				return true;
 			}
-			i++;
-			break;
 		}
+		else if (c == '\0')
+			break;
+	}
+	return false;
+}
+
+static inline bool
+_needs_member_index(int childCount)
+{
+	return S_JSON_MEMBER_INDEX_THRESHOLD > 0 && childCount >= S_JSON_MEMBER_INDEX_THRESHOLD;
+}
+
+// open addressing, load factor <= 0.5
+static inline unsigned int
+_member_index_capacity(int childCount)
+{
+	unsigned int capacity = 1u;
+	while (capacity < 2u * (unsigned int)childCount)
+		capacity <<= 1;
+	return capacity;
+}
+
+// [mask, slots...]
+static inline size_t
+_member_index_size(int childCount)
+{
+	return (1u + (size_t)_member_index_capacity(childCount)) * sizeof(unsigned int);
+}
+
+// names must already be placed (first occurrence of a duplicate name wins)
+static void
+_build_member_index(sJsonObject* object)
+{
+	const unsigned int capacity = _member_index_capacity(object->childCount);
+	unsigned int* table = (unsigned int*)object->children + object->memberIndex;
+	table[0] = capacity - 1u;
+	memset(&table[1], 0, capacity * sizeof(unsigned int));
+	for (int i = 0; i < object->childCount; i++)
+	{
+		const sJsonObject& member = object->children[i];
+		unsigned int slot = sJsonKey::hash_name(member.name, (size_t)member.nameLength) & table[0];
+		while (table[1 + slot] != 0u)
+			slot = (slot + 1u) & table[0];
+		table[1 + slot] = (unsigned int)i + 1u;
+	}
+}
+
+static bool
+_parse_container(sJsonReader_* reader, int nodeIndex)
+{
+	const bool isObject = *reader->cursor == '{';
+	const char closing = isObject ? '}' : ']';
+	reader->nodes[nodeIndex].type = isObject ? S_JSON_TYPE_OBJECT : S_JSON_TYPE_ARRAY;
+	reader->cursor++;
+
+	if (++reader->depth > S_JSON_MAX_DEPTH)
+		return false;
+
+	_skip_whitespace(reader);
+	if (_peek(reader) == closing)
+	{
+		reader->cursor++;
+		reader->depth--;
+		return true;
+	}
 
-		case S_JSON_TOKEN_RIGHT_BRACE:
+	int childCount = 0;
+	int previousChild = -1;
+	while (true)
+	{
+		const char* name = nullptr;
+		size_t nameLength = 0u;
+		bool nameEscaped = false;
+		if (isObject)
 		{
-			parentIDStack.pop();
-			i++;
-			break;
+			_skip_whitespace(reader);
+			if (_peek(reader) != '"' || !_parse_string(reader, &name, &nameLength, &nameEscaped))
+				return false;
+			_skip_whitespace(reader);
+			if (_peek(reader) != ':')
+				return false;
+			reader->cursor++;
 		}
 
-		case S_JSON_TOKEN_RIGHT_BRACKET:
+		int child = _push_node(reader);
+		if (child == -1)
+			return false;
+		if (previousChild == -1) reader->nodes[nodeIndex].firstChild = child;
+		else                     reader->nodes[previousChild].nextSibling = child;
+		previousChild = child;
+		childCount++;
+		if (isObject)
 		{
-			parentIDStack.pop();
-			i++;
-			break;
+			reader->nodes[child].name = name;
+			reader->nodes[child].nameLength = nameLength;
+			reader->nodes[child].nameEscaped = nameEscaped;
+			reader->stringBytes += nameLength + 1;
 		}
 
-		case S_JSON_TOKEN_MEMBER:
-		{
+		if (!_parse_value(reader, child))
+			return false;
+
+		_skip_whitespace(reader);
+		char c = _peek(reader);
+		reader->cursor++;
+		if (c == closing)
+			break;
+		if (c != ',')
+			return false;
+	}
 
-			sJsonObject* newObject = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject));
-			objectArray.push_back(newObject);
-			newObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-			new (newObject->_internal) sJsonVector_<int>();
-			parentIDStack.push(objectArray.size-1);
-			(*(sJsonVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);
-			memcpy(newObject->name, (*tokens)[i].value.data, (*tokens)[i].value.size_in_bytes());
+	reader->nodes[nodeIndex].childCount = childCount;
+	if (isObject && _needs_member_index(childCount))
+		reader->indexBytes += _member_index_size(childCount);
+	reader->depth--;
+	return true;
+}
 
-			// look ahead to 2 tokens to look at type (skipping over ':' )
-			sJsonToken_ valueToken = (*tokens)[i + 2];
-			sJsonToken_Type valueType = valueToken.type;
-			if      (valueType == S_JSON_TOKEN_LEFT_BRACKET) newObject->type = S_JSON_TYPE_ARRAY;
-			else if (valueType == S_JSON_TOKEN_LEFT_BRACE)   newObject->type = S_JSON_TYPE_OBJECT;
-			else if (valueType == S_JSON_TOKEN_STRING)       newObject->type = S_JSON_TYPE_STRING;
-			else if (valueType == S_JSON_TOKEN_PRIMITIVE)
+// cursor on '[', numbers go straight to reader->packed without child nodes, returns
+// false & leaves the reader untouched if the array is empty or holds anything else
+static bool
+_parse_packed_array(sJsonReader_* reader, int nodeIndex)
+{
+	const char* opening = reader->cursor;
+	const int structuralNext = reader->structuralNext;
+	const int packedStart = reader->packed.size;
+	bool isInteger = true;
+	reader->cursor++;
+	_skip_whitespace(reader);
+	while (true)
+	{
+		char c = _peek(reader);
+		if (c != '-' && (c < '0' || c > '9'))
+			break;
+		sJsonNumber_ number;
+		const char* p = _parse_number(reader->cursor, reader->end, &number);
+		if (p == nullptr)
+			break;
+		c = p < reader->end ? *p : '\0';
+		if (c != ',' && c != ']' && c != ' ' && c != '\n' && c != '\r' && c != '\t') // as _scan_primitive, the index would skip the rest of the run
+			break;
+		reader->cursor = p;
+		if (isInteger && !number.isInteger) // switch the elements so far to doubles
+		{
+			isInteger = false;
+			for (uint64_t* element = &reader->packed.data[packedStart]; element < reader->packed.end(); element++)
 			{
-				if(valueToken.value[0] == 't')      newObject->type = S_JSON_TYPE_BOOL;
-				else if(valueToken.value[0] == 'f') newObject->type = S_JSON_TYPE_BOOL;
-				else if(valueToken.value[0] == 'n') newObject->type = S_JSON_TYPE_NULL;
-				else                                newObject->type = S_JSON_TYPE_NUMBER;
+				const double real = (double)(long long)*element;
+				memcpy(element, &real, sizeof(double));
 			}
-			i++;
-			waitingOnValue = true;
+		}
+		uint64_t bits = (uint64_t)number.integer;
+		if (!isInteger)
+		{
+			const double real = number.isInteger ? (double)number.integer : number.real;
+			memcpy(&bits, &real, sizeof(double));
+		}
+		if (!reader->packed.push_back(bits))
+			break; // out of memory, falls back to child nodes
+
+		_skip_whitespace(reader);
+		c = _peek(reader);
+		reader->cursor++;
+		if (c == ']')
+		{
+			sJsonNode_& node = reader->nodes[nodeIndex];
+			node.type = S_JSON_TYPE_ARRAY;
+			node.childCount = reader->packed.size - packedStart;
+			node.packed = true;
+			node.packedStart = packedStart;
+			node.number.isInteger = isInteger;
+			return true;
+		}
+		if (c != ',')
 			break;
+		_skip_whitespace(reader);
+	}
+	reader->cursor = opening;
+	reader->structuralNext = structuralNext;
+	reader->packed.size = packedStart;
+	return false;
+}
+
+static bool
+_parse_value(sJsonReader_* reader, int nodeIndex)
+{
+	_skip_whitespace(reader);
+	switch (_peek(reader))
+	{
+	case '{':
+	case '[':
+		if (reader->shallow && reader->depth > 0) // lazy, only the span is recorded
+		{
+			const char* start = reader->cursor;
+			if (!_skip_container(reader))
+				return false;
+			sJsonNode_& node = reader->nodes[nodeIndex];
+			node.type = *start == '{' ? S_JSON_TYPE_OBJECT : S_JSON_TYPE_ARRAY;
+			node.value = start;
+			node.valueLength = (size_t)(reader->cursor - start);
+			node.lazy = true;
+			return true;
 		}
+		if (reader->packNumbers && *reader->cursor == '[' && reader->depth < S_JSON_MAX_DEPTH && _parse_packed_array(reader, nodeIndex))
+			return true;
+		return _parse_container(reader, nodeIndex);
+	case '"':
+	{
+		const char* start = nullptr;
+		size_t length = 0u;
+		bool escaped = false;
+		if (!_parse_string(reader, &start, &length, &escaped))
+			return false;
+		sJsonNode_& node = reader->nodes[nodeIndex];
+		node.type = S_JSON_TYPE_STRING;
+		node.value = start;
+		node.valueLength = length;
+		node.valueEscaped = escaped;
+		reader->stringBytes += length + 1;
+		return true;
+	}
+	case '\0':
+		return false;
+	default:
+		return _parse_primitive(reader, nodeIndex);
+	}
+}
 
-		case S_JSON_TOKEN_STRING:
+static size_t
+_encode_utf8(unsigned int codepoint, char* dst)
+{
+	if (codepoint < 0x80)    { dst[0] = (char)codepoint; return 1;}
+	if (codepoint < 0x800)   { dst[0] = (char)(0xC0 | (codepoint >> 6));  dst[1] = (char)(0x80 | (codepoint & 0x3F)); return 2;}
+	if (codepoint < 0x10000) { dst[0] = (char)(0xE0 | (codepoint >> 12)); dst[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F)); dst[2] = (char)(0x80 | (codepoint & 0x3F)); return 3;}
+	dst[0] = (char)(0xF0 | (codepoint >> 18)); dst[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F)); dst[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F)); dst[3] = (char)(0x80 | (codepoint & 0x3F));
+	return 4;
+}
+
+// decodes escapes from src into dst (dst may equal src, output never exceeds input), returns decoded length
+// runs between backslashes are found with memchr & moved as a whole, lone surrogates become U+FFFD
+static size_t
+_decode_string(const char* src, size_t length, char* dst)
+{
+	size_t out = 0u;
+	size_t i = 0u;
+	while (i < length)
+	{
+		const char* backslash = (const char*)memchr(src + i, '\\', length - i);
+		const size_t run = (backslash ? (size_t)(backslash - src) : length) - i;
+		if (dst + out != src + i)
+			memmove(dst + out, src + i, run);
+		out += run;
+		i += run;
+		if (i + 1 >= length) // no escape left (or a trailing backslash, kept as is)
+		{
+			if (i < length)
+				dst[out++] = src[i++];
+			break;
+		}
+		const char c = src[i + 1];
+		i += 2;
+		switch (c)
 		{
-			if(waitingOnValue)
+		case 'b': dst[out++] = '\b'; break;
+		case 'f': dst[out++] = '\f'; break;
+		case 'n': dst[out++] = '\n'; break;
+		case 'r': dst[out++] = '\r'; break;
+		case 't': dst[out++] = '\t'; break;
+		case 'u':
+		{
+			unsigned int codepoint = 0u;
+			if (i + 4 > length || !_parse_hex4(&src[i], &codepoint))
 			{
-				parent->value = (*tokens)[i].value.data;
-				waitingOnValue=false;
-				parentIDStack.pop();
+				dst[out++] = c;
+				break;
 			}
-			else // in array
+			i += 4;
+			unsigned int low = 0u;
+			if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 6 <= length && src[i] == '\\' && src[i + 1] == 'u'
+				&& _parse_hex4(&src[i + 2], &low) && low >= 0xDC00 && low <= 0xDFFF) // surrogate pair
 			{
-				sJsonObject *newObject = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject));
-				newObject->type = S_JSON_TYPE_STRING;
-				newObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-				new (newObject->_internal) sJsonVector_<int>();
-				objectArray.push_back(newObject);
-				newObject->value = (*tokens)[i].value.data;
-				(*(sJsonVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);	
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+				i += 6;
 			}
-			i++;
+			else if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+				codepoint = 0xFFFD;
+			out += _encode_utf8(codepoint, &dst[out]);
 			break;
 		}
+		default: dst[out++] = c; break; // '"', '\\', '/'
+		}
+	}
+	return out;
+}
+
+// writes a decoded, null terminated copy of a span to dst (dst == src in situ), returns decoded length
+static size_t
+_place_string(const char* src, size_t length, bool escaped, char* dst)
+{
+	if (escaped)
+		length = _decode_string(src, length, dst);
+	else if (dst != src)
+		memcpy(dst, src, length);
+	dst[length] = 0;
+	return length;
+}
+
+// lays out the scratch nodes breadth-first in a single block:
+//   [ sJsonObject x nodeCount | packed array elements | member hash tables | string bytes ]
+// so each object's children are contiguous & the whole tree is freed at once.
+// In situ, strings stay in the input (the byte after each span is a quote or
+// delimiter and becomes the terminator) & only a root primitive ending the
+// input needs string bytes.
+// Expanding a lazy container, node 0 is written to target & the block (chained
+// to the document) holds the rest.
+static sJsonObject*
+_layout_dom(sJsonReader_* reader, sAllocator* allocator, bool inSitu, sJsonDocument_* document=nullptr, sJsonObject* target=nullptr)
+{
+	const int nodeCount = reader->nodes.size;
+	const sJsonNode_& root = reader->nodes.data[0];
+	size_t stringBytes = reader->stringBytes;
+	if (inSitu)
+		stringBytes = root.value && root.value + root.valueLength >= reader->end ? root.valueLength + 1 : 0u;
+
+	const int first = target ? 1 : 0;
+	const size_t headerBytes = target ? sizeof(void*) : 0u;
+	size_t objectBytes = sizeof(sJsonObject) * (size_t)(nodeCount - first);
+	size_t packedBytes = sizeof(uint64_t) * (size_t)reader->packed.size;
+	if (!reader->order.resize(nodeCount))
+		return nullptr;
+	char* block = (char*)_json_alloc(allocator, headerBytes + objectBytes + packedBytes + reader->indexBytes + stringBytes);
+	if (block == nullptr)
+		return nullptr;
+	if (target)
+	{
+		*(void**)block = document->blocks;
+		document->blocks = block;
+	}
+	sJsonObject* objects = (sJsonObject*)(block + headerBytes);
+	uint64_t* packed = (uint64_t*)((char*)objects + objectBytes);
+	unsigned int* tables = (unsigned int*)((char*)packed + packedBytes);
+	char* strings = (char*)tables + reader->indexBytes;
+	if (packedBytes)
+		memcpy(packed, reader->packed.data, packedBytes);
 
-		case S_JSON_TOKEN_PRIMITIVE:
+	int* order = reader->order.data;
+	order[0] = 0;
+	int placed = 1;
+	for (int slot = 0; slot < nodeCount; slot++)
+	{
+		const sJsonNode_& node = reader->nodes.data[order[slot]];
+		sJsonObject& object = slot < first ? *target : objects[slot - first];
+		object.type = node.type;
+		object.childCount = node.childCount;
+		object.children = node.childCount > 0 && !node.packed ? &objects[placed - first] : nullptr;
+		object.name = "";
+		object.nameLength = 0;
+		object.value = nullptr;
+		object.valueLength = 0;
+		object.isInteger = node.number.isInteger;
+		object.isLazy = node.lazy;
+		object.isPacked = node.packed;
+		object.memberIndex = 0u;
+		if (node.type == S_JSON_TYPE_OBJECT && _needs_member_index(node.childCount))
 		{
-			if(waitingOnValue)
-			{
-				parent->value = (*tokens)[i].value.data;
-				waitingOnValue=false;
-				parentIDStack.pop();
-			}
-			else // in array
+			object.memberIndex = (unsigned int)(tables - (unsigned int*)object.children);
+			tables += _member_index_size(node.childCount) / sizeof(unsigned int);
+			if (!reader->indexed.push_back(slot)) // out of memory
 			{
-				sJsonObject *newObject = (sJsonObject*)S_JSON_ALLOC(sizeof(sJsonObject));
-				if((*tokens)[i].value.data[0] == 't')      newObject->type = S_JSON_TYPE_BOOL;
-				else if((*tokens)[i].value.data[0] == 'f') newObject->type = S_JSON_TYPE_BOOL;
-				else if((*tokens)[i].value.data[0] == 'n') newObject->type = S_JSON_TYPE_NULL;
-				else                                       newObject->type = S_JSON_TYPE_NUMBER;
-				newObject->_internal = (sJsonVector_<int>*)S_JSON_ALLOC(sizeof(sJsonVector_<int>));
-				new (newObject->_internal) sJsonVector_<int>();
-				objectArray.push_back(newObject);
-				newObject->value = (*tokens)[i].value.data;
-				(*(sJsonVector_<int>*)(parent->_internal)).push_back(objectArray.size-1);	
+				if (target)
+					document->blocks = *(void**)block;
+				_json_free(allocator, block);
+				return nullptr;
 			}
-			i++;
-			break;
 		}
-
-		default:
-			i++;
-			break;
+		if (node.type == S_JSON_TYPE_OBJECT || node.type == S_JSON_TYPE_ARRAY) object.number.document = document;
+		else if (node.number.isInteger)                                         object.number.integer = node.number.integer;
+		else                                                                    object.number.real = node.number.real;
+		if (node.name)
+		{
+			char* dst = inSitu ? (char*)node.name : strings;
+			object.name = dst;
+			object.nameLength = (int)_place_string(node.name, node.nameLength, node.nameEscaped, dst);
+			if (!inSitu) strings += object.nameLength + 1;
+		}
+		if (node.packed)
+			object.value = (char*)&packed[node.packedStart];
+		else if (node.lazy)
+		{
+			object.value = (char*)node.value;
+			object.valueLength = (int)node.valueLength;
+		}
+		else if (node.value)
+		{
+			char* dst = inSitu && node.value + node.valueLength < reader->end ? (char*)node.value : strings;
+			object.value = dst;
+			object.valueLength = (int)_place_string(node.value, node.valueLength, node.valueEscaped, dst);
+			if (dst == strings) strings += object.valueLength + 1;
 		}
+		for (int child = node.firstChild; child != -1; child = reader->nodes.data[child].nextSibling)
+			order[placed++] = child;
+	}
 
+	for (int i = 0; i < reader->indexed.size; i++)
+	{
+		const int slot = reader->indexed.data[i];
+		_build_member_index(slot < first ? target : &objects[slot - first]);
 	}
-	parentIDStack.pop();
-	_update_children_pointers(rootObject, &objectArray);
-	objectArray.clear();
-	parentIDStack.data.clear();
-	return rootObject;
+	return target ? target : objects;
+}
+
+static inline void
+_begin_reading(sJsonReader_* reader, const char* data, size_t size)
+{
+	reader->base = data;
+	reader->cursor = data;
+	reader->end = data + size;
+	reader->nodes.size = 0;
+	reader->order.size = 0;
+	reader->indexed.size = 0;
+	reader->packed.size = 0;
+	reader->stringBytes = 0u;
+	reader->indexBytes = 0u;
+	reader->depth = 0;
+}
+
+static void
+_initialize_reader(sJsonReader_* reader, sAllocator* allocator)
+{
+	reader->nodes.allocator = allocator;
+	reader->order.allocator = allocator;
+	reader->indexed.allocator = allocator;
+	reader->packed.allocator = allocator;
+}
+
+static void
+_release_reader(sJsonReader_* reader)
+{
+	if (reader->structuralBuffer)
+		_json_free(reader->nodes.allocator, reader->structuralBuffer);
+	reader->structuralBuffer = reader->structurals = nullptr;
+	reader->structuralCapacity = 0u;
+	reader->nodes.clear();
+	reader->order.clear();
+	reader->indexed.clear();
+	reader->packed.clear();
 }
 
 static void
-_free_json(sJsonObject* object)
+_free_document(sJsonDocument_* document)
+{
+	for (void* block = document->blocks; block != nullptr;)
+	{
+		void* next = *(void**)block;
+		_json_free(document->allocator, block);
+		block = next;
+	}
+	_release_reader(&document->reader);
+	_json_free(document->allocator, document);
+}
+
+// parses one document, the reader's scratch vectors (and their allocator) are
+// kept so callers parsing many documents can reuse them
+static sJsonObject*
+_load_json(sJsonReader_* reader, char* rawData, size_t size, sAllocator* allocator, sJsonLoadFlags flags)
 {
-	for(int i = 0; i < object->childCount; i++)
+	_begin_reading(reader, rawData, size);
+	reader->shallow = (flags & S_JSON_LOAD_FLAGS_LAZY) != 0;
+	reader->packNumbers = (flags & S_JSON_LOAD_FLAGS_PACK_NUMBERS) != 0;
+
+	// rough guess that avoids most regrowth without overshooting (a node is ~5x its smallest text)
+	int expectedNodes = reader->shallow ? 64 : (int)((size < ((size_t)1 << 30) ? size : ((size_t)1 << 30)) / 64) + 16;
+	bool success = true;
+#ifdef SEMPER_JSON_SIMD
+	reader->structuralNext = 0;
+	if (!reader->shallow && size <= (size_t)0x7FFFFFFF) // skipping subtrees beats indexing them, entries are 32 bit
+	{
+		success = _build_structural_index(reader, reader->nodes.allocator);
+		expectedNodes = reader->structuralCount / 2 + 16; // each value starts an entry & all but the last are followed by one
+	}
+#endif
+	reader->nodes.reserve(expectedNodes);
+
+	success = success && _push_node(reader) == 0 && _parse_value(reader, 0);
+	if (success)
 	{
-		_free_json(&object->children[i]);
+		_skip_whitespace(reader);
+		if (reader->cursor < reader->end)
+			success = false;
 	}
-	if(object->childCount > 0)
-		S_JSON_FREE(object->children);
+
+	const bool inSitu = (flags & S_JSON_LOAD_FLAGS_IN_SITU) != 0;
+	sJsonDocument_* document = nullptr;
+	if (success && reader->shallow && reader->nodes.size > 1) // some child may be lazy
+	{
+		document = (sJsonDocument_*)_json_alloc(allocator, sizeof(sJsonDocument_));
+		success = document != nullptr;
+		if (document)
+		{
+			memset((void*)document, 0, sizeof(sJsonDocument_));
+			document->allocator = allocator;
+			_initialize_reader(&document->reader, allocator); // lives as long as the tree
+			document->reader.shallow = true;
+			document->reader.packNumbers = reader->packNumbers;
+			document->inSitu = inSitu;
+		}
+	}
+
+	sJsonObject* rootObject = success ? _layout_dom(reader, allocator, inSitu, document) : nullptr;
+	if (rootObject == nullptr && document)
+		_free_document(document);
+	reader->structurals = nullptr; // the buffer stays for the next document
+	return rootObject;
+}
+
+sJsonObject*
+Semper::load_json(char* rawData, size_t size, sAllocator* allocator, sJsonLoadFlags flags)
+{
+	S_JSON_ASSERT(rawData);
+	sJsonReader_ reader{};
+	_initialize_reader(&reader, nullptr); // scratch stays out of the caller's (possibly linear) allocator
+	sJsonObject* rootObject = _load_json(&reader, rawData, size, allocator, flags);
+	_release_reader(&reader);
+	return rootObject;
 }
 
 void
-Semper::free_json(sJsonObject** rootObjectPtr)
+Semper::free_json(sJsonObject** rootObjectPtr, sAllocator* allocator)
 {
 	sJsonObject* rootObject = *rootObjectPtr;
-	_free_json(rootObject);
-	S_JSON_FREE(rootObject);
-	rootObjectPtr = nullptr;
+	if (rootObject && (rootObject->type == S_JSON_TYPE_OBJECT || rootObject->type == S_JSON_TYPE_ARRAY) && rootObject->number.document)
+		_free_document((sJsonDocument_*)rootObject->number.document); // blocks of expanded containers
+	if(rootObject)
+		_json_free(allocator, rootObject); // objects & strings share one block
+	*rootObjectPtr = nullptr;
+}
+
+bool
+Semper::expand_json(sJsonObject* object)
+{
+	if (!object->isLazy)
+		return true;
+	sJsonDocument_* document = (sJsonDocument_*)object->number.document;
+	sJsonReader_* reader = &document->reader;
+	_begin_reading(reader, object->value, (size_t)object->valueLength);
+	object->isLazy = false;
+	object->value = nullptr;
+	object->valueLength = 0;
+
+	const char* name = object->name; // layout resets node 0's name
+	const int nameLength = object->nameLength;
+	const bool success = _push_node(reader) == 0 && _parse_value(reader, 0) && _layout_dom(reader, document->allocator, document->inSitu, document, object);
+	object->name = name;
+	object->nameLength = nameLength;
+	if (!success)
+	{
+		object->childCount = 0; // malformed subtree reads as empty
+		object->children = nullptr;
+		object->memberIndex = 0u;
+		object->isPacked = false;
+		object->number.document = document;
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Parser context
+//-----------------------------------------------------------------------------
+
+// the layout's single request gets the kept block, regrown with some headroom when too small
+static void*
+_parser_request_memory(void* userData, size_t size, size_t alignment)
+{
+	(void)alignment; // S_JSON_ALLOC/user allocator alignment
+	sJsonParser* parser = (sJsonParser*)userData;
+	if (size > parser->blockCapacity)
+	{
+		if (parser->block)
+			_json_free(parser->allocator, parser->block);
+		const size_t capacity = size + size / 4u;
+		parser->block = _json_alloc(parser->allocator, capacity);
+		parser->blockCapacity = parser->block ? capacity : 0u;
+	}
+	return parser->block;
+}
+
+static void
+_parser_return_memory(void* userData, void* ptr)
+{
+	(void)userData; (void)ptr; // block is kept until free_json_parser
+}
+
+void
+Semper::initialize_json_parser(sJsonParser* parser, sAllocator* allocator)
+{
+	memset(parser, 0, sizeof(sJsonParser));
+	parser->allocator = allocator;
+	parser->blockAllocator.request_memory = _parser_request_memory;
+	parser->blockAllocator.return_memory = _parser_return_memory;
+	parser->blockAllocator.userData = parser;
+	sJsonReader_* reader = (sJsonReader_*)_json_alloc(allocator, sizeof(sJsonReader_));
+	S_JSON_ASSERT(reader);
+	memset((void*)reader, 0, sizeof(sJsonReader_));
+	_initialize_reader(reader, allocator);
+	parser->reader = reader;
+}
+
+sJsonObject*
+Semper::parse_json(sJsonParser* parser, char* rawData, size_t size, sJsonLoadFlags flags)
+{
+	S_JSON_ASSERT(rawData && parser->reader);
+	S_JSON_ASSERT(!(flags & S_JSON_LOAD_FLAGS_LAZY) && "Lazy trees outlive the parser's block.");
+	flags &= ~S_JSON_LOAD_FLAGS_LAZY;
+	return _load_json((sJsonReader_*)parser->reader, rawData, size, &parser->blockAllocator, flags);
+}
+
+void
+Semper::free_json_parser(sJsonParser* parser)
+{
+	if (parser->reader)
+	{
+		_release_reader((sJsonReader_*)parser->reader);
+		_json_free(parser->allocator, parser->reader);
+	}
+	if (parser->block)
+		_json_free(parser->allocator, parser->block);
+	memset(parser, 0, sizeof(sJsonParser));
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Streaming
+//-----------------------------------------------------------------------------
+
+enum sJsonExpect_
+{
+	S_JSON_EXPECT_VALUE_,
+	S_JSON_EXPECT_VALUE_OR_END_, // after '['
+	S_JSON_EXPECT_KEY_OR_END_,   // after '{'
+	S_JSON_EXPECT_KEY_,          // after ',' in an object
+	S_JSON_EXPECT_COLON_,
+	S_JSON_EXPECT_COMMA_OR_END_, // after a value inside an object or array
+	S_JSON_EXPECT_NOTHING_,      // root value complete
+};
+
+static bool
+_stream_append(sJsonStream* stream, const char* data, size_t size)
+{
+	if (stream->tokenSize + size + 1 > stream->tokenCapacity)
+	{
+		size_t capacity = stream->tokenCapacity ? stream->tokenCapacity * 2 : 256u;
+		while (capacity < stream->tokenSize + size + 1)
+			capacity *= 2;
+		char* token = (char*)_json_alloc(stream->allocator, capacity);
+		if (token == nullptr)
+			return false;
+		if (stream->token)
+		{
+			memcpy(token, stream->token, stream->tokenSize);
+			_json_free(stream->allocator, stream->token);
+		}
+		stream->token = token;
+		stream->tokenCapacity = capacity;
+	}
+	memcpy(stream->token + stream->tokenSize, data, size);
+	stream->tokenSize += size;
+	return true;
+}
+
+static inline sJsonEvent
+_stream_error(sJsonStream* stream)
+{
+	stream->partial = 0;
+	return stream->event = S_JSON_EVENT_ERROR;
 }
 
+static inline sJsonEvent
+_stream_value_done(sJsonStream* stream, sJsonEvent event)
+{
+	stream->expect = stream->depth == 0 ? S_JSON_EXPECT_NOTHING_ : S_JSON_EXPECT_COMMA_OR_END_;
+	return stream->event = event;
+}
+
+// continues the token in progress, returns 1 when complete (span set), 0 if the chunk ran out, -1 on error
+static int
+_stream_lex(sJsonStream* stream, const char** span, size_t* spanLength)
+{
+	const char* start = stream->cursor;
+	const char* p = start;
+	const char* end = stream->end;
+
+	if (stream->partial == '"')
+	{
+		bool escape = stream->escapePending;
+		for (; p < end; p++)
+		{
+			while (!escape && end - p >= S_JSON_STRING_BLOCK_) // skip plain runs
+			{
+				const int plain = _plain_prefix(p);
+				p += plain;
+				if (plain < S_JSON_STRING_BLOCK_)
+					break;
+			}
+			if (p == end)
+				break;
+			if (escape)          escape = false;
+			else if (*p == '\\') escape = true;
+			else if (*p == '"')  break;
+		}
+		if (!_stream_append(stream, start, (size_t)(p - start)))
+			return -1;
+		if (p == end)
+		{
+			stream->cursor = p;
+			stream->escapePending = escape;
+			if (stream->lastChunk)
+				return -1;
+			return 0;
+		}
+		stream->cursor = p + 1;
+		bool escaped = false;
+		if (_scan_string(stream->token, stream->token + stream->tokenSize, &escaped) != stream->token + stream->tokenSize)
+			return -1;
+		stream->tokenSize = _place_string(stream->token, stream->tokenSize, escaped, stream->token);
+		*span = stream->token;
+		*spanLength = stream->tokenSize;
+		return 1;
+	}
+
+	// number or literal, validated once complete
+	for (; p < end; p++)
+	{
+		char c = *p;
+		if ((c < '0' || c > '9') && (c < 'a' || c > 'z') && (c < 'A' || c > 'Z') && c != '-' && c != '+' && c != '.')
+			break;
+	}
+	stream->cursor = p;
+	if (p == end && !stream->lastChunk)
+		return _stream_append(stream, start, (size_t)(p - start)) ? 0 : -1;
+	if (stream->tokenSize == 0u) // entirely inside this chunk
+	{
+		*span = start;
+		*spanLength = (size_t)(p - start);
+		return 1;
+	}
+	if (!_stream_append(stream, start, (size_t)(p - start)))
+		return -1;
+	*span = stream->token;
+	*spanLength = stream->tokenSize;
+	return 1;
+}
+
+static sJsonEvent
+_stream_finish_token(sJsonStream* stream, const char* span, size_t length)
+{
+	if (stream->partial == '"')
+	{
+		stream->partial = 0;
+		stream->text = span;
+		stream->textLength = (int)length;
+		if (stream->expect == S_JSON_EXPECT_KEY_ || stream->expect == S_JSON_EXPECT_KEY_OR_END_)
+		{
+			stream->expect = S_JSON_EXPECT_COLON_;
+			return stream->event = S_JSON_EVENT_KEY;
+		}
+		return _stream_value_done(stream, S_JSON_EVENT_STRING);
+	}
+
+	stream->partial = 0;
+	if ((length == 4 && memcmp(span, "true", 4) == 0) || (length == 5 && memcmp(span, "false", 5) == 0))
+	{
+		stream->boolean = span[0] == 't';
+		return _stream_value_done(stream, S_JSON_EVENT_BOOL);
+	}
+	if (length == 4 && memcmp(span, "null", 4) == 0)
+		return _stream_value_done(stream, S_JSON_EVENT_NULL);
+
+	sJsonNumber_ number{};
+	if (length == 0u || (span[0] != '-' && (span[0] < '0' || span[0] > '9')) || _parse_number(span, span + length, &number) != span + length)
+		return _stream_error(stream);
+	stream->isInteger = number.isInteger;
+	if (number.isInteger) stream->number.integer = number.integer;
+	else                  stream->number.real = number.real;
+	return _stream_value_done(stream, S_JSON_EVENT_NUMBER);
+}
+
+void
+Semper::initialize_json_stream(sJsonStream* stream, sAllocator* allocator)
+{
+	memset(stream, 0, sizeof(sJsonStream));
+	stream->allocator = allocator;
+	stream->expect = S_JSON_EXPECT_VALUE_;
+	stream->event = S_JSON_EVENT_NONE;
+}
+
+void
+Semper::feed_json_stream(sJsonStream* stream, const char* data, int size, bool lastChunk)
+{
+	S_JSON_ASSERT(stream->cursor == stream->end && "Previous chunk not consumed.");
+	S_JSON_ASSERT(!stream->lastChunk && "Input already finished.");
+	stream->cursor = data;
+	stream->end = data + size;
+	stream->lastChunk = lastChunk;
+	if (stream->event == S_JSON_EVENT_NEED_INPUT)
+		stream->event = S_JSON_EVENT_NONE;
+}
+
+sJsonEvent
+Semper::next_json_event(sJsonStream* stream)
+{
+	if (stream->event == S_JSON_EVENT_ERROR || stream->event == S_JSON_EVENT_END)
+		return stream->event;
+	stream->text = nullptr;
+	stream->textLength = 0;
+
+	while (stream->partial == 0)
+	{
+		const char* p = stream->cursor;
+		while (p < stream->end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+			p++;
+		stream->cursor = p;
+		if (p == stream->end)
+		{
+			if (!stream->lastChunk)
+				return stream->event = S_JSON_EVENT_NEED_INPUT;
+			if (stream->expect == S_JSON_EXPECT_NOTHING_)
+				return stream->event = S_JSON_EVENT_END;
+			return _stream_error(stream);
+		}
+
+		const char c = *p;
+		const unsigned char top = stream->depth > 0 ? stream->containers[stream->depth - 1] : 0;
+		switch (stream->expect)
+		{
+		case S_JSON_EXPECT_NOTHING_:
+			return _stream_error(stream);
+
+		case S_JSON_EXPECT_COLON_:
+			if (c != ':')
+				return _stream_error(stream);
+			stream->cursor++;
+			stream->expect = S_JSON_EXPECT_VALUE_;
+			continue;
+
+		case S_JSON_EXPECT_COMMA_OR_END_:
+			if (c == ',')
+			{
+				stream->cursor++;
+				stream->expect = top == '{' ? S_JSON_EXPECT_KEY_ : S_JSON_EXPECT_VALUE_;
+				continue;
+			}
+			if ((c == '}' && top == '{') || (c == ']' && top == '['))
+				break;
+			return _stream_error(stream);
+
+		case S_JSON_EXPECT_KEY_OR_END_:
+		case S_JSON_EXPECT_KEY_:
+			if (c == '}' && stream->expect == S_JSON_EXPECT_KEY_OR_END_)
+				break;
+			if (c != '"')
+				return _stream_error(stream);
+			break;
+
+		case S_JSON_EXPECT_VALUE_OR_END_:
+		case S_JSON_EXPECT_VALUE_:
+			if (c == ']' && stream->expect == S_JSON_EXPECT_VALUE_OR_END_)
+				break;
+			if (c == '}' || c == ']' || c == ',' || c == ':')
+				return _stream_error(stream);
+			break;
+		}
+
+		stream->cursor++;
+		if (c == '{' || c == '[')
+		{
+			if (stream->depth == S_JSON_MAX_DEPTH)
+				return _stream_error(stream);
+			stream->containers[stream->depth++] = (unsigned char)c;
+			stream->expect = c == '{' ? S_JSON_EXPECT_KEY_OR_END_ : S_JSON_EXPECT_VALUE_OR_END_;
+			return stream->event = c == '{' ? S_JSON_EVENT_BEGIN_OBJECT : S_JSON_EVENT_BEGIN_ARRAY;
+		}
+		if (c == '}' || c == ']')
+		{
+			stream->depth--;
+			return _stream_value_done(stream, c == '}' ? S_JSON_EVENT_END_OBJECT : S_JSON_EVENT_END_ARRAY);
+		}
+		stream->tokenSize = 0u;
+		if (c == '"')
+		{
+			stream->partial = '"';
+			stream->escapePending = false;
+		}
+		else
+		{
+			stream->partial = '0';
+			stream->cursor--; // first character belongs to the token
+		}
+	}
+
+	const char* span = nullptr;
+	size_t length = 0u;
+	int result = _stream_lex(stream, &span, &length);
+	if (result < 0)
+		return _stream_error(stream);
+	if (result == 0)
+		return stream->event = S_JSON_EVENT_NEED_INPUT;
+	return _stream_finish_token(stream, span, length);
+}
+
+void
+Semper::free_json_stream(sJsonStream* stream)
+{
+	if (stream->token)
+		_json_free(stream->allocator, stream->token);
+	stream->token = nullptr;
+	stream->tokenSize = stream->tokenCapacity = 0u;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Writer
+//-----------------------------------------------------------------------------
+// Doubles are formatted with Grisu2 (Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers"): the shortest digits that round trip
+// in nearly all cases, always digits that round trip. The cached powers of ten
+// come from the powers of five table used by the number parser.
+
+struct sJsonDiyFp_
+{
+	uint64_t f;
+	int      e;
+};
+
+static inline sJsonDiyFp_
+_diyfp_multiply(sJsonDiyFp_ a, sJsonDiyFp_ b)
+{
+	uint64_t high = 0u;
+	uint64_t low = 0u;
+	_multiply_128(a.f, b.f, &high, &low);
+	return { high + (low >> 63), a.e + b.e + 64 }; // rounded
+}
+
+static inline sJsonDiyFp_
+_diyfp_normalize(sJsonDiyFp_ value)
+{
+	int shift = _json_count_leading_zeros(value.f);
+	return { value.f << shift, value.e - shift };
+}
+
+// 10^k rounded to 64 bits
+static inline sJsonDiyFp_
+_cached_power_of_ten(int k)
+{
+	const uint64_t* power = g_semperJsonPowersOfFive[k + 342];
+	sJsonDiyFp_ result = { power[0] + (power[1] >> 63), (int)((((int64_t)152170 + 65536) * k) >> 16) - 63 };
+	if (result.f == 0u) // rounding overflowed
+		result = { 1ull << 63, result.e + 1 };
+	return result;
+}
+
+static const uint64_t g_semperJsonPowersOfTen[20] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+	10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+	1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+static inline void
+_grisu_round(char* buffer, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance)
+{
+	while (rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+	{
+		buffer[length - 1]--;
+		rest += tenKappa;
+	}
+}
+
+static void
+_grisu_digits(sJsonDiyFp_ w, sJsonDiyFp_ upper, uint64_t delta, char* buffer, int* length, int* k)
+{
+	const sJsonDiyFp_ one = { 1ull << -upper.e, upper.e };
+	const uint64_t distance = upper.f - w.f;
+	uint32_t integral = (uint32_t)(upper.f >> -one.e);
+	uint64_t fractional = upper.f & (one.f - 1u);
+
+	int kappa = 1;
+	while (kappa < 10 && integral >= (uint32_t)g_semperJsonPowersOfTen[kappa])
+		kappa++;
+
+	*length = 0;
+	while (kappa > 0)
+	{
+		const uint32_t divisor = (uint32_t)g_semperJsonPowersOfTen[kappa - 1];
+		const uint32_t digit = integral / divisor;
+		integral %= divisor;
+		if (digit || *length)
+			buffer[(*length)++] = (char)('0' + digit);
+		kappa--;
+		const uint64_t rest = ((uint64_t)integral << -one.e) + fractional;
+		if (rest <= delta)
+		{
+			*k += kappa;
+			_grisu_round(buffer, *length, delta, rest, g_semperJsonPowersOfTen[kappa] << -one.e, distance);
+			return;
+		}
+	}
+
+	while (true)
+	{
+		fractional *= 10u;
+		delta *= 10u;
+		const char digit = (char)(fractional >> -one.e);
+		if (digit || *length)
+			buffer[(*length)++] = (char)('0' + digit);
+		fractional &= one.f - 1u;
+		kappa--;
+		if (fractional < delta)
+		{
+			*k += kappa;
+			_grisu_round(buffer, *length, delta, fractional, one.f, -kappa < 20 ? distance * g_semperJsonPowersOfTen[-kappa] : 0u);
+			return;
+		}
+	}
+}
+
+// value > 0 & finite, writes the digits & returns their count (value = digits * 10^k)
+static int
+_grisu2(double value, char* buffer, int* k)
+{
+	uint64_t bits = 0u;
+	memcpy(&bits, &value, sizeof(double));
+	const int biasedExponent = (int)((bits >> 52) & 0x7FF);
+	const uint64_t significand = bits & ((1ull << 52) - 1u);
+	sJsonDiyFp_ v = biasedExponent ? sJsonDiyFp_{ significand | (1ull << 52), biasedExponent - 1075 } : sJsonDiyFp_{ significand, -1074 };
+
+	// boundaries halfway to the neighbouring doubles
+	sJsonDiyFp_ upper = { (v.f << 1) + 1u, v.e - 1 };
+	while ((upper.f & (1ull << 53)) == 0u)
+	{
+		upper.f <<= 1;
+		upper.e--;
+	}
+	upper.f <<= 10;
+	upper.e -= 10;
+	sJsonDiyFp_ lower = significand == 0u && biasedExponent > 1 ? sJsonDiyFp_{ (v.f << 2) - 1u, v.e - 2 } : sJsonDiyFp_{ (v.f << 1) - 1u, v.e - 1 };
+	lower.f <<= lower.e - upper.e;
+	lower.e = upper.e;
+
+	// scale so the upper boundary's exponent lands in [-60, -32]
+	int mk = (int)((-61 - upper.e) * 0.30102999566398114);
+	if ((-61 - upper.e) * 0.30102999566398114 > (double)mk) mk++;
+	const sJsonDiyFp_ power = _cached_power_of_ten(mk);
+	*k = -mk;
+
+	const sJsonDiyFp_ w = _diyfp_multiply(_diyfp_normalize(v), power);
+	sJsonDiyFp_ scaledUpper = _diyfp_multiply(upper, power);
+	sJsonDiyFp_ scaledLower = _diyfp_multiply(lower, power);
+	scaledLower.f++;
+	scaledUpper.f--;
+	int length = 0;
+	_grisu_digits(w, scaledUpper, scaledUpper.f - scaledLower.f, buffer, &length, k);
+	return length;
+}
+
+static char*
+_write_exponent(int exponent, char* dst)
+{
+	*dst++ = 'e';
+	if (exponent < 0)
+	{
+		*dst++ = '-';
+		exponent = -exponent;
+	}
+	if (exponent >= 100) { *dst++ = (char)('0' + exponent / 100); exponent %= 100; *dst++ = (char)('0' + exponent / 10); }
+	else if (exponent >= 10) *dst++ = (char)('0' + exponent / 10);
+	*dst++ = (char)('0' + exponent % 10);
+	return dst;
+}
+
+// positions the digits & decimal point (value = digits * 10^k), returns one past the end
+static char*
+_place_decimal_point(char* buffer, int length, int k)
+{
+	const int point = length + k; // digits before the decimal point
+	if (k >= 0 && point <= 21) // 1234e3 -> 1234000.0
+	{
+		for (int i = length; i < point; i++)
+			buffer[i] = '0';
+		buffer[point] = '.';
+		buffer[point + 1] = '0';
+		return &buffer[point + 2];
+	}
+	if (point > 0 && point <= 21) // 1234e-2 -> 12.34
+	{
+		memmove(&buffer[point + 1], &buffer[point], (size_t)(length - point));
+		buffer[point] = '.';
+		return &buffer[length + 1];
+	}
+	if (point > -6 && point <= 0) // 1234e-6 -> 0.001234
+	{
+		const int offset = 2 - point;
+		memmove(&buffer[offset], &buffer[0], (size_t)length);
+		buffer[0] = '0';
+		buffer[1] = '.';
+		for (int i = 2; i < offset; i++)
+			buffer[i] = '0';
+		return &buffer[length + offset];
+	}
+	if (length == 1) // 1e30
+		return _write_exponent(point - 1, &buffer[1]);
+	memmove(&buffer[2], &buffer[1], (size_t)(length - 1)); // 1234e30 -> 1.234e33
+	buffer[1] = '.';
+	return _write_exponent(point - 1, &buffer[length + 1]);
+}
+
+static const char g_semperJsonDigitPairs[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+// writes value without a terminator, returns the length (dst needs 20 bytes)
+static int
+_format_int(long long value, char* dst)
+{
+	char digits[20];
+	char* end = digits + sizeof(digits);
+	char* p = end;
+	uint64_t magnitude = value < 0 ? 0u - (uint64_t)value : (uint64_t)value;
+	while (magnitude >= 100u)
+	{
+		const unsigned pair = (unsigned)(magnitude % 100u) * 2u;
+		magnitude /= 100u;
+		*--p = g_semperJsonDigitPairs[pair + 1];
+		*--p = g_semperJsonDigitPairs[pair];
+	}
+	if (magnitude >= 10u)
+	{
+		*--p = g_semperJsonDigitPairs[magnitude * 2u + 1u];
+		*--p = g_semperJsonDigitPairs[magnitude * 2u];
+	}
+	else
+		*--p = (char)('0' + magnitude);
+	int length = 0;
+	if (value < 0)
+		dst[length++] = '-';
+	memcpy(dst + length, p, (size_t)(end - p));
+	return length + (int)(end - p);
+}
+
+// writes value without a terminator, returns the length (dst needs 32 bytes), finite values only
+static int
+_format_double(double value, char* dst)
+{
+	char* p = dst;
+	if (value < 0.0 || (value == 0.0 && 1.0 / value < 0.0))
+	{
+		*p++ = '-';
+		value = -value;
+	}
+	if (value == 0.0)
+	{
+		memcpy(p, "0.0", 3);
+		return (int)(p - dst) + 3;
+	}
+	int k = 0;
+	int length = _grisu2(value, p, &k);
+	return (int)(_place_decimal_point(p, length, k) - dst);
+}
+
+// room for count more bytes plus the terminator, nullptr once the writer failed
+static char*
+_writer_reserve(sJsonWriter* writer, size_t count)
+{
+	if (writer->failed)
+		return nullptr;
+	if (writer->size + count + 1 > writer->capacity)
+	{
+		size_t capacity = writer->capacity ? writer->capacity * 2 : 4096u;
+		while (capacity < writer->size + count + 1)
+			capacity *= 2;
+		char* buffer = (char*)_json_alloc(writer->allocator, capacity);
+		if (buffer == nullptr)
+		{
+			writer->failed = true;
+			return nullptr;
+		}
+		if (writer->buffer)
+		{
+			memcpy(buffer, writer->buffer, writer->size);
+			_json_free(writer->allocator, writer->buffer);
+		}
+		writer->buffer = buffer;
+		writer->capacity = capacity;
+	}
+	return writer->buffer + writer->size;
+}
+
+static inline void
+_writer_commit(sJsonWriter* writer, size_t count)
+{
+	writer->size += count;
+	writer->buffer[writer->size] = 0;
+	if (writer->file && writer->size >= S_JSON_WRITE_FLUSH_SIZE)
+		Semper::flush_json_writer(writer);
+}
+
+static inline void
+_writer_append(sJsonWriter* writer, const char* data, size_t count)
+{
+	char* dst = _writer_reserve(writer, count);
+	if (dst == nullptr)
+		return;
+	memcpy(dst, data, count);
+	_writer_commit(writer, count);
+}
+
+static void
+_writer_newline(sJsonWriter* writer)
+{
+	const size_t count = 1u + (size_t)(writer->depth * writer->indent);
+	char* dst = _writer_reserve(writer, count);
+	if (dst == nullptr)
+		return;
+	dst[0] = '\n';
+	memset(dst + 1, ' ', count - 1u);
+	_writer_commit(writer, count);
+}
+
+// separator & indentation in front of a value or key
+static void
+_writer_prefix(sJsonWriter* writer)
+{
+	if (writer->afterKey)
+	{
+		writer->afterKey = false;
+		return;
+	}
+	if (writer->needComma)
+		_writer_append(writer, ",", 1u);
+	if ((writer->flags & S_JSON_WRITE_FLAGS_PRETTY) && writer->depth > 0)
+		_writer_newline(writer);
+	writer->needComma = true;
+}
+
+static void
+_writer_string(sJsonWriter* writer, const char* value, size_t length)
+{
+	static const char hex[] = "0123456789abcdef";
+	_writer_append(writer, "\"", 1u);
+	size_t runStart = 0u;
+	for (size_t i = 0u; i < length; i++)
+	{
+		const unsigned char c = (unsigned char)value[i];
+		if (c >= 0x20 && c != '"' && c != '\\')
+			continue;
+		_writer_append(writer, value + runStart, i - runStart);
+		runStart = i + 1;
+		char escape[6] = { '\\', 0, 0, 0, 0, 0 };
+		size_t escapeLength = 2u;
+		switch (c)
+		{
+		case '"':  escape[1] = '"';  break;
+		case '\\': escape[1] = '\\'; break;
+		case '\b': escape[1] = 'b';  break;
+		case '\f': escape[1] = 'f';  break;
+		case '\n': escape[1] = 'n';  break;
+		case '\r': escape[1] = 'r';  break;
+		case '\t': escape[1] = 't';  break;
+		default:
+			escape[1] = 'u'; escape[2] = '0'; escape[3] = '0'; escape[4] = hex[c >> 4]; escape[5] = hex[c & 0xF];
+			escapeLength = 6u;
+			break;
+		}
+		_writer_append(writer, escape, escapeLength);
+	}
+	_writer_append(writer, value + runStart, length - runStart);
+	_writer_append(writer, "\"", 1u);
+}
+
+static void
+_writer_begin(sJsonWriter* writer, char bracket)
+{
+	_writer_prefix(writer);
+	_writer_append(writer, &bracket, 1u);
+	writer->depth++;
+	writer->needComma = false;
+}
+
+static void
+_writer_end(sJsonWriter* writer, char bracket)
+{
+	S_JSON_ASSERT(writer->depth > 0 && !writer->afterKey);
+	writer->depth--;
+	if ((writer->flags & S_JSON_WRITE_FLAGS_PRETTY) && writer->needComma) // not empty
+		_writer_newline(writer);
+	_writer_append(writer, &bracket, 1u);
+	writer->needComma = true;
+}
+
+void
+Semper::initialize_json_writer(sJsonWriter* writer, FILE* file, sJsonWriteFlags flags, sAllocator* allocator)
+{
+	memset(writer, 0, sizeof(sJsonWriter));
+	writer->file = file;
+	writer->flags = flags;
+	writer->indent = 4;
+	writer->allocator = allocator;
+	if (_writer_reserve(writer, 0u))
+		writer->buffer[0] = 0;
+}
+
+void
+Semper::flush_json_writer(sJsonWriter* writer)
+{
+	if (writer->file == nullptr || writer->size == 0u)
+		return;
+	if (fwrite(writer->buffer, 1, writer->size, writer->file) != writer->size)
+		writer->failed = true;
+	writer->size = 0u;
+	writer->buffer[0] = 0;
+}
+
+void
+Semper::free_json_writer(sJsonWriter* writer)
+{
+	flush_json_writer(writer);
+	if (writer->buffer)
+		_json_free(writer->allocator, writer->buffer);
+	writer->buffer = nullptr;
+	writer->size = writer->capacity = 0u;
+}
+
+void Semper::write_json_begin_object(sJsonWriter* writer) { _writer_begin(writer, '{');}
+void Semper::write_json_end_object  (sJsonWriter* writer) { _writer_end(writer, '}');}
+void Semper::write_json_begin_array (sJsonWriter* writer) { _writer_begin(writer, '[');}
+void Semper::write_json_end_array   (sJsonWriter* writer) { _writer_end(writer, ']');}
+
+void
+Semper::write_json_key(sJsonWriter* writer, const char* key)
+{
+	S_JSON_ASSERT(writer->depth > 0 && !writer->afterKey);
+	_writer_prefix(writer);
+	_writer_string(writer, key, strlen(key));
+	if (writer->flags & S_JSON_WRITE_FLAGS_PRETTY) _writer_append(writer, ": ", 2u);
+	else                                           _writer_append(writer, ":", 1u);
+	writer->afterKey = true;
+}
+
+void
+Semper::write_json_string(sJsonWriter* writer, const char* value)
+{
+	_writer_prefix(writer);
+	_writer_string(writer, value, strlen(value));
+}
+
+void
+Semper::write_json_int(sJsonWriter* writer, long long value)
+{
+	_writer_prefix(writer);
+	char* dst = _writer_reserve(writer, 20u);
+	if (dst)
+		_writer_commit(writer, (size_t)_format_int(value, dst));
+}
+
+void
+Semper::write_json_double(sJsonWriter* writer, double value)
+{
+	_writer_prefix(writer);
+	if (value - value != 0.0) // NaN or Inf, not representable in JSON
+	{
+		_writer_append(writer, "null", 4u);
+		return;
+	}
+	char* dst = _writer_reserve(writer, 32u);
+	if (dst)
+		_writer_commit(writer, (size_t)_format_double(value, dst));
+}
+
+void
+Semper::write_json_bool(sJsonWriter* writer, bool value)
+{
+	_writer_prefix(writer);
+	if (value) _writer_append(writer, "true", 4u);
+	else       _writer_append(writer, "false", 5u);
+}
+
+void
+Semper::write_json_null(sJsonWriter* writer)
+{
+	_writer_prefix(writer);
+	_writer_append(writer, "null", 4u);
+}
+
+void
+Semper::write_json(sJsonWriter* writer, const sJsonObject* object)
+{
+	switch (object->type)
+	{
+	case S_JSON_TYPE_OBJECT:
+		if (object->isLazy) // lazy trees are decoded as they're written
+			expand_json((sJsonObject*)object);
+		write_json_begin_object(writer);
+		for (int i = 0; i < object->childCount; i++)
+		{
+			const sJsonObject& member = object->children[i];
+			_writer_prefix(writer);
+			_writer_string(writer, member.name, (size_t)member.nameLength);
+			if (writer->flags & S_JSON_WRITE_FLAGS_PRETTY) _writer_append(writer, ": ", 2u);
+			else                                           _writer_append(writer, ":", 1u);
+			writer->afterKey = true;
+			write_json(writer, &member);
+		}
+		write_json_end_object(writer);
+		break;
+	case S_JSON_TYPE_ARRAY:
+		if (object->isLazy)
+			expand_json((sJsonObject*)object);
+		write_json_begin_array(writer);
+		if (object->isPacked)
+		{
+			for (int i = 0; i < object->childCount; i++)
+			{
+				if (object->isInteger) write_json_int(writer, ((const long long*)object->value)[i]);
+				else                   write_json_double(writer, ((const double*)object->value)[i]);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < object->childCount; i++)
+				write_json(writer, &object->children[i]);
+		}
+		write_json_end_array(writer);
+		break;
+	case S_JSON_TYPE_STRING:
+		_writer_prefix(writer);
+		_writer_string(writer, object->value, (size_t)object->valueLength);
+		break;
+	case S_JSON_TYPE_NUMBER:
+		if (object->isInteger) write_json_int(writer, object->number.integer);
+		else                   write_json_double(writer, object->number.real);
+		break;
+	case S_JSON_TYPE_BOOL:
+		write_json_bool(writer, object->value[0] == 't');
+		break;
+	default:
+		write_json_null(writer);
+		break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Typed decoding
+//-----------------------------------------------------------------------------
+
+struct sJsonDecoder_
+{
+	sJsonReader_       reader;
+	sJsonVector_<char> scratch; // escaped names & strings that don't fit their buffer
+};
+
+static bool _decode_object(sJsonDecoder_* decoder, const sJsonSchema* schema, char* dst);
+
+// reals are truncated, converting one outside the range would be undefined
+static inline long long
+_clamp_integer(const sJsonNumber_& number, long long minimum, long long maximum)
+{
+	if (number.isInteger)
+		return number.integer < minimum ? minimum : number.integer > maximum ? maximum : number.integer;
+	if (!(number.real > (double)minimum)) // also catches NaN
+		return minimum;
+	if (number.real >= (double)maximum) // rounds up to 2^63 for long long, which is already out of range
+		return maximum;
+	return (long long)number.real;
+}
+
+// members usually arrive in declaration order, so the field after the last match is tried first
+static const sJsonField*
+_find_field(const sJsonSchema* schema, const char* name, size_t length, int* next)
+{
+	const unsigned int hash = sJsonKey::hash_name(name, length);
+	for (int i = 0; i < schema->fieldCount; i++)
+	{
+		const int index = (*next + i) % schema->fieldCount;
+		const sJsonField& field = schema->fields[index];
+		if (field.hash == hash && (size_t)field.nameLength == length && memcmp(field.name, name, length) == 0)
+		{
+			*next = index + 1;
+			return &field;
+		}
+	}
+	return nullptr;
+}
+
+// any value, containers are only bracket matched
+static bool
+_decode_skip(sJsonDecoder_* decoder)
+{
+	sJsonReader_* reader = &decoder->reader;
+	_skip_whitespace(reader);
+	const char c = _peek(reader);
+	if (c == '{' || c == '[')
+		return _skip_container(reader);
+	if (c == '"')
+	{
+		const char* start = nullptr;
+		size_t length = 0u;
+		bool escaped = false;
+		return _parse_string(reader, &start, &length, &escaped);
+	}
+	if (c == '\0')
+		return false;
+	sJsonType type = S_JSON_TYPE_NONE;
+	sJsonNumber_ number{};
+	return _scan_primitive(reader, &type, &number);
+}
+
+// decoded & null terminated, truncated on a UTF-8 boundary to fit size bytes
+static bool
+_decode_string_field(sJsonDecoder_* decoder, char* dst, size_t size)
+{
+	const char* start = nullptr;
+	size_t length = 0u;
+	bool escaped = false;
+	if (!_parse_string(&decoder->reader, &start, &length, &escaped))
+		return false;
+	if (escaped)
+	{
+		if (length < size) // decoding never grows a string
+		{
+			dst[_decode_string(start, length, dst)] = 0;
+			return true;
+		}
+		if (!decoder->scratch.resize((int)length + 1))
+			return false;
+		length = _decode_string(start, length, decoder->scratch.data);
+		start = decoder->scratch.data;
+	}
+	if (length >= size)
+	{
+		length = size - 1u;
+		while (length > 0u && ((unsigned char)start[length] & 0xC0) == 0x80)
+			length--;
+	}
+	memcpy(dst, start, length);
+	dst[length] = 0;
+	return true;
+}
+
+static bool
+_decode_element(sJsonDecoder_* decoder, const sJsonField* field, char* dst)
+{
+	sJsonReader_* reader = &decoder->reader;
+	_skip_whitespace(reader);
+	const char c = _peek(reader);
+	if (c == 'n') // null keeps the current value
+		return _decode_skip(decoder);
+
+	switch (field->type)
+	{
+	case S_JSON_FIELD_TYPE_STRING:
+		if (c == '"')
+			return _decode_string_field(decoder, dst, field->size);
+		break;
+	case S_JSON_FIELD_TYPE_OBJECT:
+		if (c == '{')
+			return _decode_object(decoder, field->schema, dst);
+		break;
+	default:
+	{
+		if (c == '"' || c == '{' || c == '[' || c == '\0')
+			break;
+		sJsonType type = S_JSON_TYPE_NONE;
+		sJsonNumber_ number{};
+		const char* start = reader->cursor;
+		if (!_scan_primitive(reader, &type, &number))
+			return false;
+		if (field->type == S_JSON_FIELD_TYPE_BOOL)
+		{
+			if (type != S_JSON_TYPE_BOOL)
+				break;
+			*(bool*)dst = *start == 't';
+			return true;
+		}
+		if (type != S_JSON_TYPE_NUMBER)
+			break;
+		const double real = number.isInteger ? (double)number.integer : number.real;
+		switch (field->type)
+		{
+		case S_JSON_FIELD_TYPE_INT:    *(int*)dst = (int)_clamp_integer(number, -2147483647LL - 1, 2147483647LL); break;
+		case S_JSON_FIELD_TYPE_UINT:   *(unsigned*)dst = (unsigned)_clamp_integer(number, 0, 4294967295LL); break;
+		case S_JSON_FIELD_TYPE_INT64:  *(long long*)dst = _clamp_integer(number, -9223372036854775807LL - 1, 9223372036854775807LL); break;
+		case S_JSON_FIELD_TYPE_FLOAT:  *(float*)dst = (float)(real < -3.4028234663852886e38 ? -3.4028234663852886e38 : real > 3.4028234663852886e38 ? 3.4028234663852886e38 : real); break;
+		case S_JSON_FIELD_TYPE_DOUBLE: *(double*)dst = real; break;
+		}
+		return true;
+	}
+	}
+	return false;
+}
+
+// elements past the capacity are skipped
+static bool
+_decode_field(sJsonDecoder_* decoder, const sJsonField* field, char* base)
+{
+	sJsonReader_* reader = &decoder->reader;
+	char* dst = base + field->offset;
+	if (!field->isArray)
+		return _decode_element(decoder, field, dst);
+
+	_skip_whitespace(reader);
+	if (_peek(reader) == 'n')
+		return _decode_skip(decoder);
+	if (_peek(reader) != '[')
+		return false;
+	reader->cursor++;
+	if (++reader->depth > S_JSON_MAX_DEPTH)
+		return false;
+
+	int count = 0;
+	_skip_whitespace(reader);
+	if (_peek(reader) == ']')
+		reader->cursor++;
+	else
+	{
+		while (true)
+		{
+			const bool success = count < field->capacity ? _decode_element(decoder, field, dst + (size_t)count * field->size) : _decode_skip(decoder);
+			if (!success)
+				return false;
+			count++;
+			_skip_whitespace(reader);
+			const char c = _peek(reader);
+			reader->cursor++;
+			if (c == ']')
+				break;
+			if (c != ',')
+				return false;
+		}
+	}
+	if (field->countOffset != S_JSON_NO_COUNT)
+		*(int*)(base + field->countOffset) = count < field->capacity ? count : field->capacity;
+	reader->depth--;
+	return true;
+}
+
+static bool
+_decode_object(sJsonDecoder_* decoder, const sJsonSchema* schema, char* dst)
+{
+	S_JSON_ASSERT(schema && "Object fields need a schema.");
+	sJsonReader_* reader = &decoder->reader;
+	_skip_whitespace(reader);
+	if (_peek(reader) != '{')
+		return false;
+	reader->cursor++;
+	if (++reader->depth > S_JSON_MAX_DEPTH)
+		return false;
+
+	_skip_whitespace(reader);
+	if (_peek(reader) == '}')
+	{
+		reader->cursor++;
+		reader->depth--;
+		return true;
+	}
+
+	int next = 0;
+	while (true)
+	{
+		const char* name = nullptr;
+		size_t nameLength = 0u;
+		bool nameEscaped = false;
+		_skip_whitespace(reader);
+		if (_peek(reader) != '"' || !_parse_string(reader, &name, &nameLength, &nameEscaped))
+			return false;
+		if (nameEscaped)
+		{
+			if (!decoder->scratch.resize((int)nameLength + 1))
+				return false;
+			nameLength = _decode_string(name, nameLength, decoder->scratch.data);
+			name = decoder->scratch.data;
+		}
+		_skip_whitespace(reader);
+		if (_peek(reader) != ':')
+			return false;
+		reader->cursor++;
+
+		const sJsonField* field = _find_field(schema, name, nameLength, &next);
+		if (!(field ? _decode_field(decoder, field, dst) : _decode_skip(decoder)))
+			return false;
+
+		_skip_whitespace(reader);
+		const char c = _peek(reader);
+		reader->cursor++;
+		if (c == '}')
+			break;
+		if (c != ',')
+			return false;
+	}
+	reader->depth--;
+	return true;
+}
+
+bool
+Semper::decode_json(const char* rawData, size_t size, const sJsonSchema& schema, void* out, sAllocator* allocator)
+{
+	S_JSON_ASSERT(rawData && out);
+	sJsonDecoder_ decoder{};
+	decoder.scratch.allocator = allocator;
+	_begin_reading(&decoder.reader, rawData, size);
+	bool success = _decode_object(&decoder, &schema, (char*)out);
+	if (success)
+	{
+		_skip_whitespace(&decoder.reader);
+		if (decoder.reader.cursor < decoder.reader.end)
+			success = false;
+	}
+	decoder.scratch.clear();
+	return success;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Binary cache
+//-----------------------------------------------------------------------------
+// The image is the usual single block layout behind a header:
+//   [ header | sJsonObject x objectCount | packed array elements | member hash tables | strings ]
+// with pointers stored as offsets from the header (0 stays nullptr). Loading adds
+// the image's address to each pointer, a linear pass without any parsing.
+
+struct sJsonCacheHeader_
+{
+	char     magic[4];     // "sJC1"
+	uint32_t objectSize;   // sizeof(sJsonObject)
+	uint32_t pointerSize;
+	uint32_t byteOrder;    // 0x01020304 as written
+	uint64_t objectCount;
+	uint64_t size;         // (bytes) incl. header
+	uint64_t base;         // address the pointers are relative to (0 until loaded)
+};
+
+struct sJsonCacheString_
+{
+	size_t       offset;
+	size_t       length;
+	unsigned int hash;
+};
+
+// returns the offset of an identical earlier string or appends it
+static size_t
+_cache_string(char* image, size_t* stringsEnd, sJsonVector_<sJsonCacheString_>* strings, sJsonVector_<int>* table, const char* src, size_t length)
+{
+	const unsigned int hash = sJsonKey::hash_name(src, length);
+	const unsigned int mask = (unsigned int)table->size - 1u;
+	unsigned int slot = hash & mask;
+	for (; table->data[slot] != -1; slot = (slot + 1u) & mask)
+	{
+		const sJsonCacheString_& string = strings->data[table->data[slot]];
+		if (string.hash == hash && string.length == length && memcmp(image + string.offset, src, length) == 0)
+			return string.offset;
+	}
+	sJsonCacheString_ string = { *stringsEnd, length, hash };
+	memcpy(image + string.offset, src, length);
+	image[string.offset + length] = 0;
+	*stringsEnd += length + 1;
+	table->data[slot] = strings->size;
+	strings->push_back(string);
+	return string.offset;
+}
+
+static inline char*
+_cache_pointer(size_t offset)
+{
+	return (char*)(uintptr_t)offset;
+}
+
+void*
+Semper::save_json_cache(const sJsonObject* root, size_t* size, sAllocator* allocator)
+{
+	S_JSON_ASSERT(root && size);
+	*size = 0u;
+
+	// sizes, lazy containers are expanded on the way
+	sJsonVector_<const sJsonObject*> queue(allocator);
+	bool success = queue.push_back(root);
+	size_t packedBytes = 0u;
+	size_t indexBytes = 0u;
+	size_t stringBytes = 0u; // before deduplication
+	int stringCount = 0;
+	for (int i = 0; success && i < queue.size; i++)
+	{
+		const sJsonObject* object = queue.data[i];
+		if (object->isLazy)
+			expand_json((sJsonObject*)object);
+		stringBytes += (size_t)object->nameLength + 1u;
+		stringCount++;
+		if (object->isPacked)
+			packedBytes += sizeof(uint64_t) * (size_t)object->childCount;
+		else
+		{
+			if (object->value)
+			{
+				stringBytes += (size_t)object->valueLength + 1u;
+				stringCount++;
+			}
+			if (object->memberIndex)
+				indexBytes += _member_index_size(object->childCount);
+			for (int child = 0; success && child < object->childCount; child++)
+				success = queue.push_back(&object->children[child]);
+		}
+	}
+
+	const int objectCount = queue.size;
+	const size_t objectsStart = sizeof(sJsonCacheHeader_);
+	const size_t packedStart = objectsStart + sizeof(sJsonObject) * (size_t)objectCount;
+	const size_t tablesStart = packedStart + packedBytes;
+	const size_t stringsStart = tablesStart + indexBytes;
+	char* image = success ? (char*)_json_alloc(allocator, stringsStart + stringBytes) : nullptr;
+
+	sJsonVector_<sJsonCacheString_> strings(allocator);
+	sJsonVector_<int> table(allocator);
+	int tableSize = 16;
+	while (tableSize < 2 * stringCount)
+		tableSize *= 2;
+	if (image == nullptr || !table.resize(tableSize) || !strings.reserve(stringCount)) // out of memory
+	{
+		if (image)
+			_json_free(allocator, image);
+		queue.clear();
+		table.clear();
+		return nullptr;
+	}
+	memset(table.data, 0xFF, sizeof(int) * (size_t)tableSize);
+
+	sJsonObject* objects = (sJsonObject*)(image + objectsStart);
+	size_t packedEnd = packedStart;
+	size_t tablesEnd = tablesStart;
+	size_t stringsEnd = stringsStart;
+	int placed = 1;
+	for (int slot = 0; slot < objectCount; slot++) // same breadth first order as the queue
+	{
+		const sJsonObject* src = queue.data[slot];
+		sJsonObject& object = objects[slot];
+		memset((void*)&object, 0, sizeof(sJsonObject));
+		object.type = src->type;
+		object.childCount = src->childCount;
+		object.isInteger = src->isInteger;
+		object.isPacked = src->isPacked;
+		object.nameLength = src->nameLength;
+		object.valueLength = src->valueLength;
+		object.name = _cache_pointer(_cache_string(image, &stringsEnd, &strings, &table, src->name, (size_t)src->nameLength));
+		if (src->type == S_JSON_TYPE_NUMBER)
+			object.number = src->number;
+		if (src->isPacked)
+		{
+			const size_t bytes = sizeof(uint64_t) * (size_t)src->childCount;
+			memcpy(image + packedEnd, src->value, bytes);
+			object.value = _cache_pointer(packedEnd);
+			packedEnd += bytes;
+			continue;
+		}
+		if (src->value)
+			object.value = _cache_pointer(_cache_string(image, &stringsEnd, &strings, &table, src->value, (size_t)src->valueLength));
+		if (src->childCount > 0)
+		{
+			object.children = (sJsonObject*)_cache_pointer(objectsStart + sizeof(sJsonObject) * (size_t)placed);
+			placed += src->childCount;
+		}
+		if (src->memberIndex) // slots hold child indices, so the table copies as is
+		{
+			const size_t bytes = _member_index_size(src->childCount);
+			memcpy(image + tablesEnd, (const unsigned int*)src->children + src->memberIndex, bytes);
+			object.memberIndex = (unsigned int)((tablesEnd - ((size_t)object.children)) / sizeof(unsigned int));
+			tablesEnd += bytes;
+		}
+	}
+
+	sJsonCacheHeader_* header = (sJsonCacheHeader_*)image;
+	memcpy(header->magic, "sJC1", 4);
+	header->objectSize = (uint32_t)sizeof(sJsonObject);
+	header->pointerSize = (uint32_t)sizeof(void*);
+	header->byteOrder = 0x01020304u;
+	header->objectCount = (uint64_t)objectCount;
+	header->size = (uint64_t)stringsEnd;
+	header->base = 0u;
+	*size = stringsEnd;
+
+	queue.clear();
+	strings.clear();
+	table.clear();
+	return image;
+}
+
+void
+Semper::free_json_cache(void* cache, sAllocator* allocator)
+{
+	if (cache)
+		_json_free(allocator, cache);
+}
+
+sJsonObject*
+Semper::load_json_cache(void* data, size_t size)
+{
+	S_JSON_ASSERT(data && ((uintptr_t)data & 7u) == 0u);
+	sJsonCacheHeader_* header = (sJsonCacheHeader_*)data;
+	if (size < sizeof(sJsonCacheHeader_) || memcmp(header->magic, "sJC1", 4) != 0 || header->objectSize != sizeof(sJsonObject) ||
+		header->pointerSize != sizeof(void*) || header->byteOrder != 0x01020304u || header->size > size || header->objectCount == 0u ||
+		sizeof(sJsonCacheHeader_) + header->objectCount * sizeof(sJsonObject) > header->size)
+		return nullptr;
+
+	// pointers are relative to header->base, the image may have moved since the last load
+	sJsonObject* objects = (sJsonObject*)((char*)data + sizeof(sJsonCacheHeader_));
+	const uintptr_t base = (uintptr_t)data;
+	const uintptr_t previous = (uintptr_t)header->base;
+	if (previous != base)
+	{
+		const uintptr_t limit = (uintptr_t)header->size;
+		for (uint64_t i = 0u; i < header->objectCount; i++)
+		{
+			sJsonObject& object = objects[i];
+			const uintptr_t children = (uintptr_t)object.children - (object.children ? previous : 0u);
+			const uintptr_t name = (uintptr_t)object.name - previous;
+			const uintptr_t value = (uintptr_t)object.value - (object.value ? previous : 0u);
+			if (children >= limit || name >= limit || value >= limit)
+				return nullptr;
+			object.children = object.children ? (sJsonObject*)(base + children) : nullptr;
+			object.name = (const char*)(base + name);
+			object.value = object.value ? (char*)(base + value) : nullptr;
+		}
+		header->base = (uint64_t)base;
+	}
+	return objects;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Path queries
+//-----------------------------------------------------------------------------
+// A path compiles to one step per token, each with its member name hashed up
+// front (getMember(sJsonKey) skips strlen & hashing) & its array index parsed.
+// Sets merge their paths into a prefix tree, so a query walks the document
+// once & resolves each shared prefix a single time.
+
+// prefix tree node, children & the paths ending here are linked lists
+struct sJsonPathNode_
+{
+	const sJsonPathStep* step;       // nullptr for the root
+	int                  firstChild;
+	int                  nextSibling;
+	int                  firstPath;  // -1 if no path ends here
+};
+
+// "0" or digits without a leading zero that fit an int, -1 otherwise
+static int
+_path_index(const char* token, int length)
+{
+	if (length == 0 || length > 9 || (token[0] == '0' && length > 1))
+		return -1;
+	int index = 0;
+	for (int i = 0; i < length; i++)
+	{
+		if (token[i] < '0' || token[i] > '9')
+			return -1;
+		index = index * 10 + (token[i] - '0');
+	}
+	return index;
+}
+
+static inline sJsonObject*
+_query_step(sJsonObject* object, const sJsonPathStep& step)
+{
+	if (object->isLazy && !Semper::expand_json(object))
+		return nullptr;
+	if (object->type == S_JSON_TYPE_OBJECT)
+		return object->getMember(step.key);
+	if (object->type == S_JSON_TYPE_ARRAY && !object->isPacked && step.index >= 0 && step.index < object->childCount)
+		return &object->children[step.index];
+	return nullptr;
+}
+
+static bool
+_path_error(sJsonPath* compiled)
+{
+	Semper::free_json_path(compiled);
+	return false;
+}
+
+bool
+Semper::compile_json_path(const char* path, sJsonPath* compiled, sAllocator* allocator)
+{
+	S_JSON_ASSERT(path && compiled);
+	memset(compiled, 0, sizeof(sJsonPath));
+	compiled->_allocator = allocator;
+
+	const bool pointer = path[0] == '/' || path[0] == 0;
+	const size_t length = strlen(path);
+	int maxSteps = pointer ? 0 : 1;
+	for (size_t i = 0u; i < length; i++)
+		maxSteps += pointer ? path[i] == '/' : (path[i] == '.' || path[i] == '[');
+	if (maxSteps > S_JSON_MAX_DEPTH)
+		return false;
+	if (maxSteps == 0) // "" is the root itself
+		return true;
+
+	// [ steps | names ], unescaped names are never longer than their tokens
+	char* block = (char*)_json_alloc(allocator, sizeof(sJsonPathStep) * (size_t)maxSteps + length + (size_t)maxSteps);
+	if (block == nullptr)
+		return false;
+	compiled->steps = (sJsonPathStep*)block;
+	char* names = block + sizeof(sJsonPathStep) * (size_t)maxSteps;
+
+	const char* p = path;
+	const char* end = path + length;
+	while (p < end)
+	{
+		char* name = names;
+		if (pointer)
+		{
+			for (p++; p < end && *p != '/'; p++)
+			{
+				if (*p != '~')
+					*names++ = *p;
+				else if (p + 1 < end && (p[1] == '0' || p[1] == '1'))
+					*names++ = *++p == '0' ? '~' : '/';
+				else
+					return _path_error(compiled);
+			}
+		}
+		else
+		{
+			if (p != path && *p == '.')
+				p++;
+			if (p < end && *p == '[')
+			{
+				for (p++; p < end && *p != ']'; p++)
+					*names++ = *p;
+				if (p == end || _path_index(name, (int)(names - name)) < 0 || (p + 1 < end && p[1] != '.' && p[1] != '['))
+					return _path_error(compiled);
+				p++;
+			}
+			else
+			{
+				for (; p < end && *p != '.' && *p != '['; p++)
+					*names++ = *p;
+			}
+			if (names == name)
+				return _path_error(compiled);
+		}
+		const int nameLength = (int)(names - name);
+		*names++ = 0;
+		sJsonPathStep& step = compiled->steps[compiled->stepCount++];
+		step.key = sJsonKey(name, nameLength);
+		step.index = _path_index(name, nameLength);
+	}
+	return true;
+}
+
+void
+Semper::free_json_path(sJsonPath* compiled)
+{
+	if (compiled->steps)
+		_json_free(compiled->_allocator, compiled->steps);
+	compiled->steps = nullptr;
+	compiled->stepCount = 0;
+}
+
+sJsonObject*
+Semper::query_json(sJsonObject* root, const sJsonPath& path)
+{
+	sJsonObject* object = root;
+	for (int i = 0; i < path.stepCount && object; i++)
+		object = _query_step(object, path.steps[i]);
+	return object;
+}
+
+bool
+Semper::compile_json_paths(const char* const* paths, int pathCount, sJsonPathSet* compiled, sAllocator* allocator)
+{
+	S_JSON_ASSERT(paths && compiled && pathCount >= 0);
+	memset(compiled, 0, sizeof(sJsonPathSet));
+	compiled->_allocator = allocator;
+	compiled->_paths = (sJsonPath*)_json_alloc(allocator, sizeof(sJsonPath) * (size_t)(pathCount > 0 ? pathCount : 1));
+	compiled->_nextPath = (int*)_json_alloc(allocator, sizeof(int) * (size_t)(pathCount > 0 ? pathCount : 1));
+	if (compiled->_paths == nullptr || compiled->_nextPath == nullptr)
+	{
+		free_json_paths(compiled);
+		return false;
+	}
+	memset(compiled->_paths, 0, sizeof(sJsonPath) * (size_t)pathCount);
+
+	int stepCount = 0;
+	for (int i = 0; i < pathCount; i++, compiled->pathCount++)
+	{
+		if (!compile_json_path(paths[i], &compiled->_paths[i], allocator))
+		{
+			free_json_paths(compiled);
+			return false;
+		}
+		stepCount += compiled->_paths[i].stepCount;
+	}
+
+	sJsonPathNode_* nodes = (sJsonPathNode_*)_json_alloc(allocator, sizeof(sJsonPathNode_) * (size_t)(stepCount + 1)); // worst case nothing is shared
+	if (nodes == nullptr)
+	{
+		free_json_paths(compiled);
+		return false;
+	}
+	compiled->_nodes = nodes;
+	nodes[0] = { nullptr, -1, -1, -1 };
+	int nodeCount = 1;
+	for (int i = 0; i < pathCount; i++)
+	{
+		const sJsonPath& path = compiled->_paths[i];
+		int node = 0;
+		for (int s = 0; s < path.stepCount; s++)
+		{
+			const sJsonKey& key = path.steps[s].key;
+			int child = nodes[node].firstChild;
+			for (; child >= 0; child = nodes[child].nextSibling)
+			{
+				const sJsonKey& other = nodes[child].step->key;
+				if (other.hash == key.hash && other.length == key.length && memcmp(other.name, key.name, (size_t)key.length) == 0)
+					break;
+			}
+			if (child < 0)
+			{
+				child = nodeCount++;
+				nodes[child] = { &path.steps[s], -1, nodes[node].firstChild, -1 };
+				nodes[node].firstChild = child;
+			}
+			node = child;
+		}
+		compiled->_nextPath[i] = nodes[node].firstPath;
+		nodes[node].firstPath = i;
+	}
+	compiled->_nodeCount = nodeCount;
+	return true;
+}
+
+void
+Semper::free_json_paths(sJsonPathSet* compiled)
+{
+	if (compiled->_paths)
+	{
+		for (int i = 0; i < compiled->pathCount; i++)
+			free_json_path(&compiled->_paths[i]);
+		_json_free(compiled->_allocator, compiled->_paths);
+	}
+	if (compiled->_nodes)
+		_json_free(compiled->_allocator, compiled->_nodes);
+	if (compiled->_nextPath)
+		_json_free(compiled->_allocator, compiled->_nextPath);
+	memset(compiled, 0, sizeof(sJsonPathSet));
+}
+
+static void
+_query_node(const sJsonPathSet& paths, int node, sJsonObject* object, sJsonObject** results)
+{
+	const sJsonPathNode_* nodes = (const sJsonPathNode_*)paths._nodes;
+	for (int path = nodes[node].firstPath; path >= 0; path = paths._nextPath[path])
+		results[path] = object;
+	for (int child = nodes[node].firstChild; child >= 0; child = nodes[child].nextSibling)
+	{
+		sJsonObject* value = _query_step(object, *nodes[child].step);
+		if (value)
+			_query_node(paths, child, value, results);
+	}
+}
+
+void
+Semper::query_json(sJsonObject* root, const sJsonPathSet& paths, sJsonObject** results)
+{
+	S_JSON_ASSERT(results || paths.pathCount == 0);
+	for (int i = 0; i < paths.pathCount; i++)
+		results[i] = nullptr;
+	if (root && paths._nodes)
+		_query_node(paths, 0, root, results);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Files
+//-----------------------------------------------------------------------------
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct sJsonMappedFile_
+{
+	const char* data;   // writable when mapped copy on write
+	size_t      size;
+	bool        mapped; // false: read into an S_JSON_ALLOC buffer
+#if defined(_WIN32)
+	HANDLE      file;
+	HANDLE      mapping;
+#endif
+};
+
+// copyOnWrite: pages may be written (only the touched ones get private copies)
+static bool
+_map_file(const char* path, sJsonMappedFile_* file, bool copyOnWrite=false)
+{
+	memset(file, 0, sizeof(sJsonMappedFile_));
+#if defined(_WIN32)
+	file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file->file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	GetFileSizeEx(file->file, &size);
+	file->size = (size_t)size.QuadPart;
+	if (file->size == 0u)
+	{
+		CloseHandle(file->file);
+		file->file = nullptr;
+		return true;
+	}
+	file->mapping = CreateFileMappingA(file->file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+	if (file->mapping)
+		file->data = (const char*)MapViewOfFile(file->mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+	if (file->data)
+	{
+		file->mapped = true;
+		return true;
+	}
+	if (file->mapping) CloseHandle(file->mapping);
+	CloseHandle(file->file);
+	file->file = file->mapping = nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+	int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0)
+		return false;
+	struct stat info;
+	if (fstat(descriptor, &info) == 0)
+	{
+		file->size = (size_t)info.st_size;
+		if (file->size == 0u)
+		{
+			close(descriptor);
+			return true;
+		}
+		void* data = mmap(nullptr, file->size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (data != MAP_FAILED)
+		{
+			close(descriptor); // the mapping keeps the file alive
+			file->data = (const char*)data;
+			file->mapped = true;
+			return true;
+		}
+	}
+	close(descriptor);
+#endif
+
+	// no mapping available, read the whole file
+	FILE* stream = fopen(path, "rb");
+	if (stream == nullptr)
+		return false;
+	fseek(stream, 0, SEEK_END);
+	long size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* data = size > 0 ? (char*)S_JSON_ALLOC((size_t)size) : nullptr;
+	file->size = data && fread(data, 1, (size_t)size, stream) == (size_t)size ? (size_t)size : 0u;
+	file->data = data;
+	fclose(stream);
+	return size <= 0 || file->size > 0u;
+}
+
+static void
+_unmap_file(sJsonMappedFile_* file)
+{
+	if (file->mapped)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(file->data);
+		CloseHandle(file->mapping);
+		CloseHandle(file->file);
+#elif defined(__unix__) || defined(__APPLE__)
+		munmap((void*)file->data, file->size);
+#endif
+	}
+	else if (file->data)
+		S_JSON_FREE((void*)file->data);
+	memset(file, 0, sizeof(sJsonMappedFile_));
+}
+
+bool
+Semper::load_json_file(const char* path, sJsonFile* file, sJsonLoadFlags flags, sAllocator* allocator)
+{
+	S_JSON_ASSERT(path && file);
+	memset(file, 0, sizeof(sJsonFile));
+	file->_allocator = allocator;
+
+	const bool inSitu = (flags & S_JSON_LOAD_FLAGS_IN_SITU) != 0;
+	sJsonMappedFile_ mapped;
+	if (!_map_file(path, &mapped, inSitu))
+		return false;
+	file->size = mapped.size;
+	if (mapped.size > 0u)
+		file->root = Semper::load_json((char*)mapped.data, mapped.size, allocator, flags);
+
+	if (file->root && (flags & (S_JSON_LOAD_FLAGS_IN_SITU | S_JSON_LOAD_FLAGS_LAZY))) // the tree points into the mapping
+	{
+		file->_mapping = _json_alloc(allocator, sizeof(sJsonMappedFile_));
+		if (file->_mapping)
+			memcpy(file->_mapping, &mapped, sizeof(sJsonMappedFile_));
+		else
+			Semper::free_json(&file->root, allocator);
+	}
+	if (file->_mapping == nullptr)
+		_unmap_file(&mapped);
+	return file->root != nullptr;
+}
+
+void
+Semper::free_json_file(sJsonFile* file)
+{
+	if (file->root)
+		Semper::free_json(&file->root, file->_allocator);
+	if (file->_mapping)
+	{
+		_unmap_file((sJsonMappedFile_*)file->_mapping);
+		_json_free(file->_allocator, file->_mapping);
+	}
+	memset(file, 0, sizeof(sJsonFile));
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Benchmark
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_JSON_BENCHMARK)
+
+#include <chrono>
+
+#ifndef S_JSON_BENCH_CHUNK_SIZE
+#define S_JSON_BENCH_CHUNK_SIZE 65536 // streaming mode feeds the input in chunks of this many bytes
+#endif
+
+enum sJsonBenchMode_
+{
+	S_JSON_BENCH_MODE_DOM_,
+	S_JSON_BENCH_MODE_IN_SITU_,
+	S_JSON_BENCH_MODE_LAZY_,         // root only, containers stay undecoded
+	S_JSON_BENCH_MODE_PACK_NUMBERS_,
+	S_JSON_BENCH_MODE_PARSER_,       // one sJsonParser reused for every document & pass
+	S_JSON_BENCH_MODE_STREAM_,       // events pulled until the end, no tree
+	S_JSON_BENCH_MODE_COUNT_
+};
+
+static const char* g_semperJsonBenchModeNames[S_JSON_BENCH_MODE_COUNT_] = { "dom", "in_situ", "lazy", "pack_numbers", "parser", "stream" };
+
+struct sJsonBenchCorpus_
+{
+	const char* name;
+	char*       data;
+	size_t      size;
+	size_t*     offsets;  // document d spans [offsets[d], offsets[d + 1])
+	size_t      documentCount;
+};
+
+// counts requests & tracks the high-water mark (size stored in front of each block)
+struct sJsonBenchCounter_
+{
+	size_t live;
+	size_t peak;
+	size_t requests;
+};
+
+static void*
+_json_bench_request(void* userData, size_t size, size_t alignment)
+{
+	S_JSON_ASSERT(alignment <= 16u);
+	(void)alignment;
+	sJsonBenchCounter_* counter = (sJsonBenchCounter_*)userData;
+	char* block = (char*)S_JSON_ALLOC(size + 16u);
+	if (block == nullptr)
+		return nullptr;
+	memcpy(block, &size, sizeof(size_t));
+	counter->live += size;
+	if (counter->live > counter->peak)
+		counter->peak = counter->live;
+	counter->requests++;
+	return block + 16;
+}
+
+static void
+_json_bench_return(void* userData, void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+	sJsonBenchCounter_* counter = (sJsonBenchCounter_*)userData;
+	char* block = (char*)ptr - 16;
+	size_t size;
+	memcpy(&size, block, sizeof(size_t));
+	counter->live -= size;
+	S_JSON_FREE(block);
+}
+
+static unsigned int
+_json_bench_random(unsigned int* state) // xorshift32
+{
+	unsigned int x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static double
+_json_bench_random_real(unsigned int* state) // mixed magnitudes, 1e-6 .. 1e6
+{
+	static const double scales[] = { 1e-6, 1e-4, 1e-2, 1.0, 1e2, 1e4, 1e6 };
+	const double unit = (double)_json_bench_random(state) / 4294967296.0 - 0.5;
+	return unit * scales[_json_bench_random(state) % 7u];
+}
+
+// words with the occasional character that needs escaping or is multi-byte UTF-8
+static void
+_json_bench_random_text(unsigned int* state, char* text, int maxWords)
+{
+	static const char* words[] = { "alpha", "beta", "gamma", "delta", "semper", "json", "value", "member", "array", "object",
+		"line\nbreak", "tab\tstop", "\"quoted\"", "back\\slash", "caf\xC3\xA9", "\xE2\x82\xAC" "42", "ctrl\x01", "\xF0\x9F\x98\x80" };
+	const int wordCount = 1 + (int)(_json_bench_random(state) % (unsigned int)maxWords);
+	size_t length = 0u;
+	for (int i = 0; i < wordCount; i++)
+	{
+		const unsigned int pick = _json_bench_random(state) % 64u;
+		const char* word = words[pick < 40u ? pick % 10u : 10u + pick % 8u]; // escapes in ~1 of 3 words
+		const size_t wordLength = strlen(word);
+		if (i > 0)
+			text[length++] = ' ';
+		memcpy(text + length, word, wordLength);
+		length += wordLength;
+	}
+	text[length] = 0;
+}
+
+static void
+_json_bench_nested_record(sJsonWriter* writer, unsigned int* state, int depth)
+{
+	char text[256];
+	Semper::write_json_begin_object(writer);
+	Semper::write_json_key(writer, "id");
+	Semper::write_json_int(writer, (long long)_json_bench_random(state));
+	Semper::write_json_key(writer, "name");
+	_json_bench_random_text(state, text, 2);
+	Semper::write_json_string(writer, text);
+	if (depth > 0)
+	{
+		Semper::write_json_key(writer, "child");
+		_json_bench_nested_record(writer, state, depth - 1);
+	}
+	else
+	{
+		Semper::write_json_key(writer, "leaf");
+		Semper::write_json_bool(writer, true);
+	}
+	Semper::write_json_end_object(writer);
+}
+
+static void
+_json_bench_generate_nested(sJsonWriter* writer, size_t size, unsigned int seed)
+{
+	Semper::write_json_begin_array(writer);
+	while (writer->size < size)
+		_json_bench_nested_record(writer, &seed, 64 + (int)(_json_bench_random(&seed) % 192u)); // stays below S_JSON_MAX_DEPTH
+	Semper::write_json_end_array(writer);
+}
+
+static void
+_json_bench_generate_numbers(sJsonWriter* writer, size_t size, unsigned int seed)
+{
+	Semper::write_json_begin_object(writer);
+	Semper::write_json_key(writer, "ids");
+	Semper::write_json_begin_array(writer);
+	while (writer->size < size / 3u)
+		Semper::write_json_int(writer, (long long)(_json_bench_random(&seed) >> (_json_bench_random(&seed) % 32u)));
+	Semper::write_json_end_array(writer);
+	Semper::write_json_key(writer, "samples");
+	Semper::write_json_begin_array(writer);
+	while (writer->size < size / 3u * 2u)
+		Semper::write_json_double(writer, _json_bench_random_real(&seed));
+	Semper::write_json_end_array(writer);
+	Semper::write_json_key(writer, "transforms");
+	Semper::write_json_begin_array(writer);
+	while (writer->size < size)
+	{
+		Semper::write_json_begin_array(writer);
+		for (int i = 0; i < 16; i++)
+			Semper::write_json_double(writer, _json_bench_random_real(&seed));
+		Semper::write_json_end_array(writer);
+	}
+	Semper::write_json_end_array(writer);
+	Semper::write_json_end_object(writer);
+}
+
+static void
+_json_bench_generate_strings(sJsonWriter* writer, size_t size, unsigned int seed)
+{
+	char text[256];
+	Semper::write_json_begin_array(writer);
+	while (writer->size < size)
+	{
+		Semper::write_json_begin_object(writer);
+		Semper::write_json_key(writer, "title");
+		_json_bench_random_text(&seed, text, 4);
+		Semper::write_json_string(writer, text);
+		Semper::write_json_key(writer, "body");
+		_json_bench_random_text(&seed, text, 24);
+		Semper::write_json_string(writer, text);
+		Semper::write_json_key(writer, "tags");
+		Semper::write_json_begin_array(writer);
+		for (unsigned int i = _json_bench_random(&seed) % 5u; i > 0u; i--)
+		{
+			_json_bench_random_text(&seed, text, 1);
+			Semper::write_json_string(writer, text);
+		}
+		Semper::write_json_end_array(writer);
+		Semper::write_json_end_object(writer);
+	}
+	Semper::write_json_end_array(writer);
+}
+
+// event records of S_JSON_MEMBER_INDEX_THRESHOLD+ members, one per line
+static size_t
+_json_bench_generate_small(sJsonWriter* writer, size_t size, unsigned int seed, size_t* offsets, size_t maxDocuments)
+{
+	static const char* metrics[] = { "cpu", "memory", "disk", "network", "latency", "errors", "requests", "queue",
+		"threads", "handles", "uptime", "temperature", "power", "fan" };
+	char text[256];
+	size_t documentCount = 0u;
+	while (writer->size < size && documentCount < maxDocuments)
+	{
+		offsets[documentCount++] = writer->size;
+		Semper::write_json_begin_object(writer);
+		Semper::write_json_key(writer, "id");
+		Semper::write_json_int(writer, (long long)documentCount);
+		Semper::write_json_key(writer, "host");
+		_json_bench_random_text(&seed, text, 2);
+		Semper::write_json_string(writer, text);
+		Semper::write_json_key(writer, "active");
+		Semper::write_json_bool(writer, (_json_bench_random(&seed) & 1u) != 0u);
+		Semper::write_json_key(writer, "timestamp");
+		Semper::write_json_int(writer, 1700000000ll + (long long)_json_bench_random(&seed) % 100000000ll);
+		for (int i = 0; i < 14; i++)
+		{
+			Semper::write_json_key(writer, metrics[i]);
+			Semper::write_json_double(writer, _json_bench_random_real(&seed));
+		}
+		Semper::write_json_end_object(writer);
+		_writer_append(writer, "\n", 1u);
+		writer->needComma = false; // next line is a new root
+	}
+	offsets[documentCount] = writer->size;
+	return documentCount;
+}
+
+static bool
+_json_bench_generate(sJsonBenchCorpus_* corpus, int index, size_t size)
+{
+	static const char* names[] = { "nested", "numbers", "strings", "small" };
+	sJsonWriter writer;
+	Semper::initialize_json_writer(&writer);
+	corpus->name = names[index];
+	corpus->documentCount = 1u;
+	corpus->offsets = (size_t*)S_JSON_ALLOC(sizeof(size_t) * (index == 3 ? size / 64u + 2u : 2u));
+	if (corpus->offsets == nullptr)
+	{
+		Semper::free_json_writer(&writer);
+		return false;
+	}
+	switch (index)
+	{
+	case 0: _json_bench_generate_nested (&writer, size, 0x9E3779B9u); break;
+	case 1: _json_bench_generate_numbers(&writer, size, 0x85EBCA6Bu); break;
+	case 2: _json_bench_generate_strings(&writer, size, 0xC2B2AE35u); break;
+	case 3: corpus->documentCount = _json_bench_generate_small(&writer, size, 0x27D4EB2Fu, corpus->offsets, size / 64u); break;
+	}
+	if (index != 3)
+	{
+		corpus->offsets[0] = 0u;
+		corpus->offsets[1] = writer.size;
+	}
+	corpus->data = writer.buffer; // owned by the corpus now
+	corpus->size = writer.size;
+	if (writer.failed)
+	{
+		S_JSON_FREE(corpus->data);
+		S_JSON_FREE(corpus->offsets);
+		return false;
+	}
+	return true;
+}
+
+static double
+_json_bench_elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+_json_bench_collect_members(sJsonObject* object, sJsonVector_<sJsonObject*>& objects, sJsonVector_<const char*>& names)
+{
+	if (object->isLazy)
+		Semper::expand_json(object);
+	if (object->isPacked || object->children == nullptr)
+		return;
+	for (int i = 0; i < object->childCount; i++)
+	{
+		if (object->type == S_JSON_TYPE_OBJECT)
+		{
+			objects.push_back(object);
+			names.push_back(object->children[i].name);
+		}
+		if (object->children[i].type == S_JSON_TYPE_OBJECT || object->children[i].type == S_JSON_TYPE_ARRAY)
+			_json_bench_collect_members(&object->children[i], objects, names);
+	}
+}
+
+// every member name of every object looked up on its object, round robin until ~2M calls
+static double
+_json_bench_lookup(sJsonObject** roots, size_t rootCount)
+{
+	sJsonVector_<sJsonObject*> objects;
+	sJsonVector_<const char*> names;
+	for (size_t i = 0u; i < rootCount; i++)
+		_json_bench_collect_members(roots[i], objects, names);
+	if (objects.empty())
+		return -1.0;
+
+	const size_t calls = objects.size < 2000000 ? ((size_t)2000000 / (size_t)objects.size + 1u) * (size_t)objects.size : (size_t)objects.size;
+	size_t found = 0u;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t call = 0u; call < calls; call++)
+	{
+		const int i = (int)(call % (size_t)objects.size);
+		found += objects.data[i]->getMember(names.data[i]) != nullptr;
+	}
+	const double seconds = _json_bench_elapsed(start);
+	S_JSON_ASSERT(found == calls);
+	(void)found;
+	objects.clear();
+	names.clear();
+	return seconds * 1.0e9 / (double)calls;
+}
+
+static bool
+_json_bench_stream(char* data, size_t size, sAllocator* allocator)
+{
+	sJsonStream stream;
+	Semper::initialize_json_stream(&stream, allocator);
+	size_t offset = 0u;
+	sJsonEvent event = S_JSON_EVENT_NEED_INPUT;
+	for (;;)
+	{
+		if (event == S_JSON_EVENT_NEED_INPUT)
+		{
+			const size_t chunk = size - offset < (size_t)S_JSON_BENCH_CHUNK_SIZE ? size - offset : (size_t)S_JSON_BENCH_CHUNK_SIZE;
+			Semper::feed_json_stream(&stream, data + offset, (int)chunk, offset + chunk == size);
+			offset += chunk;
+		}
+		event = Semper::next_json_event(&stream);
+		if (event == S_JSON_EVENT_END || event == S_JSON_EVENT_ERROR)
+			break;
+	}
+	Semper::free_json_stream(&stream);
+	return event == S_JSON_EVENT_END;
+}
+
+static void
+_json_bench_run(const sJsonBenchCorpus_* corpus, int mode, int passes, sJsonBenchmarkResult* result)
+{
+	static const sJsonLoadFlags modeFlags[S_JSON_BENCH_MODE_COUNT_] = { S_JSON_LOAD_FLAGS_NONE, S_JSON_LOAD_FLAGS_IN_SITU,
+		S_JSON_LOAD_FLAGS_LAZY, S_JSON_LOAD_FLAGS_PACK_NUMBERS, S_JSON_LOAD_FLAGS_NONE, S_JSON_LOAD_FLAGS_NONE };
+
+	memset(result, 0, sizeof(sJsonBenchmarkResult));
+	result->corpus = corpus->name;
+	result->mode = g_semperJsonBenchModeNames[mode];
+	result->bytes = corpus->size;
+	result->documents = corpus->documentCount;
+	result->seconds = 1.0e30;
+	result->lookupNs = -1.0;
+
+	char* work = (char*)S_JSON_ALLOC(corpus->size + 1u); // in situ & lazy loads keep pointing into (or modify) the input
+	if (work == nullptr)
+		return;
+	sJsonBenchCounter_ counter = {};
+	sAllocator allocator = { _json_bench_request, _json_bench_return, &counter };
+	sJsonParser parser;
+	if (mode == S_JSON_BENCH_MODE_PARSER_)
+		Semper::initialize_json_parser(&parser, &allocator);
+
+	for (int pass = 0; pass < passes; pass++)
+	{
+		memcpy(work, corpus->data, corpus->size);
+		const size_t requests = counter.requests;
+		size_t failures = 0u;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t d = 0u; d < corpus->documentCount; d++)
+		{
+			char* document = work + corpus->offsets[d];
+			const size_t size = corpus->offsets[d + 1] - corpus->offsets[d];
+			if (mode == S_JSON_BENCH_MODE_PARSER_)
+			{
+				failures += Semper::parse_json(&parser, document, size) == nullptr;
+			}
+			else if (mode == S_JSON_BENCH_MODE_STREAM_)
+			{
+				failures += !_json_bench_stream(document, size, &allocator);
+			}
+			else
+			{
+				sJsonObject* root = Semper::load_json(document, size, &allocator, modeFlags[mode]);
+				failures += root == nullptr;
+				if (root)
+					Semper::free_json(&root, &allocator);
+			}
+		}
+		const double seconds = _json_bench_elapsed(start);
+		if (seconds < result->seconds)
+			result->seconds = seconds;
+		result->allocations = counter.requests - requests;
+		result->failures = failures;
+	}
+	result->peakBytes = counter.peak;
+	result->mbPerSecond = (double)corpus->size / (1024.0 * 1024.0) / result->seconds;
+
+	// lookups on trees kept alive at once (the parser only holds its last document)
+	if (mode == S_JSON_BENCH_MODE_PARSER_)
+	{
+		memcpy(work, corpus->data, corpus->size);
+		sJsonObject* root = Semper::parse_json(&parser, work, corpus->offsets[1]);
+		if (root)
+			result->lookupNs = _json_bench_lookup(&root, 1u);
+		Semper::free_json_parser(&parser);
+	}
+	else if (mode != S_JSON_BENCH_MODE_STREAM_)
+	{
+		memcpy(work, corpus->data, corpus->size);
+		const size_t rootCount = corpus->documentCount < 4096u ? corpus->documentCount : 4096u;
+		sJsonObject** roots = (sJsonObject**)S_JSON_ALLOC(sizeof(sJsonObject*) * rootCount);
+		size_t loaded = 0u;
+		for (; roots && loaded < rootCount; loaded++)
+		{
+			roots[loaded] = Semper::load_json(work + corpus->offsets[loaded], corpus->offsets[loaded + 1] - corpus->offsets[loaded], &allocator, modeFlags[mode]);
+			if (roots[loaded] == nullptr)
+				break;
+		}
+		if (roots && loaded == rootCount)
+			result->lookupNs = _json_bench_lookup(roots, rootCount);
+		for (size_t i = 0u; i < loaded; i++)
+			Semper::free_json(&roots[i], &allocator);
+		if (roots)
+			S_JSON_FREE(roots);
+	}
+	S_JSON_ASSERT(counter.live == 0u);
+	S_JSON_FREE(work);
+}
+
+int
+Semper::run_json_benchmark(sJsonBenchmarkResult* results, int maxResults, size_t corpusSize, int passes)
+{
+	S_JSON_ASSERT(results);
+	S_JSON_ASSERT(corpusSize > 0u && passes > 0);
+
+	int resultCount = 0;
+	for (int c = 0; c < 4; c++)
+	{
+		sJsonBenchCorpus_ corpus;
+		if (!_json_bench_generate(&corpus, c, corpusSize))
+		{
+			S_JSON_ASSERT(false && "Failed to generate benchmark corpus.");
+			continue;
+		}
+		for (int mode = 0; mode < S_JSON_BENCH_MODE_COUNT_ && resultCount < maxResults; mode++)
+			_json_bench_run(&corpus, mode, passes, &results[resultCount++]);
+		S_JSON_FREE(corpus.data);
+		S_JSON_FREE(corpus.offsets);
+	}
+	return resultCount;
+}
+
+void
+Semper::print_json_benchmark(const sJsonBenchmarkResult* results, int count)
+{
+#ifdef SEMPER_JSON_SIMD
+	printf("structural index: on\n");
+#else
+	printf("structural index: off\n");
+#endif
+	printf("%-10s %-14s %8s %8s %10s %12s %12s %10s %8s\n", "corpus", "mode", "MB", "docs", "MB/s", "peak(KB)", "allocs", "lookup(ns)", "failures");
+	for (int i = 0; i < count; i++)
+	{
+		const sJsonBenchmarkResult& r = results[i];
+		printf("%-10s %-14s %8.2f %8zu %10.1f %12.1f %12zu ", r.corpus, r.mode, (double)r.bytes / (1024.0 * 1024.0), r.documents, r.mbPerSecond, (double)r.peakBytes / 1024.0, r.allocations);
+		if (r.lookupNs < 0.0) printf("%10s %8zu\n", "-", r.failures);
+		else                  printf("%10.1f %8zu\n", r.lookupNs, r.failures);
+	}
+}
+
+#endif // SEMPER_JSON_BENCHMARK
+
+//-----------------------------------------------------------------------------
+// [SECTION] NDJSON
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_JSON_NDJSON)
+
+#include <new> // placement new
+#include <thread>
+#include <atomic>
+
+// bump allocator over a list of S_JSON_ALLOC blocks, one per worker
+struct sJsonArenaBlock_
+{
+	sJsonArenaBlock_* next;
+	size_t            capacity;
+	size_t            used;
+	size_t            padding_; // keeps data 16 byte aligned
+};
+
+struct sJsonArena_
+{
+	sJsonArenaBlock_* first;
+	sJsonArenaBlock_* current;
+};
+
+static void*
+_arena_request_memory(void* userData, size_t size, size_t alignment)
+{
+	sJsonArena_* arena = (sJsonArena_*)userData;
+	sJsonArenaBlock_* block = arena->current;
+	while (block)
+	{
+		size_t offset = (block->used + alignment - 1u) & ~(alignment - 1u);
+		if (offset + size <= block->capacity)
+		{
+			block->used = offset + size;
+			arena->current = block;
+			return (char*)(block + 1) + offset;
+		}
+		if (block->next == nullptr)
+			break;
+		block = block->next;
+		block->used = 0u; // blocks after current are free (after a rewind)
+	}
+
+	size_t capacity = size + alignment > S_JSON_NDJSON_BLOCK_SIZE ? size + alignment : S_JSON_NDJSON_BLOCK_SIZE;
+	sJsonArenaBlock_* newBlock = (sJsonArenaBlock_*)S_JSON_ALLOC(sizeof(sJsonArenaBlock_) + capacity);
+	if (newBlock == nullptr)
+		return nullptr;
+	newBlock->next = nullptr;
+	newBlock->capacity = capacity;
+	newBlock->used = 0u;
+	if (block) block->next = newBlock;
+	else       arena->first = newBlock;
+	arena->current = newBlock;
+	return _arena_request_memory(userData, size, alignment);
+}
+
+static void
+_arena_return_memory(void*, void*)
+{
+}
+
+static void
+_arena_rewind(sJsonArena_* arena)
+{
+	arena->current = arena->first;
+	if (arena->first)
+		arena->first->used = 0u;
+}
+
+static void
+_arena_free(sJsonArena_* arena)
+{
+	for (sJsonArenaBlock_* block = arena->first; block;)
+	{
+		sJsonArenaBlock_* next = block->next;
+		S_JSON_FREE(block);
+		block = next;
+	}
+	arena->first = arena->current = nullptr;
+}
+
+struct sJsonNdjsonJob_
+{
+	const char*                 data;
+	size_t*                     chunkStarts;  // chunkCount + 1 line aligned offsets
+	int                         chunkCount;
+	std::atomic<int>            nextChunk;
+	sJsonArena_*                arenas;       // one per worker
+	sJsonVector_<sJsonObject*>* chunkRecords; // batch mode, one per chunk
+	size_t*                     chunkErrors;
+	sJsonRecordFunc             callback;     // callback mode
+	void*                       userData;
+};
+
+static void
+_ndjson_worker(sJsonNdjsonJob_* job, int worker)
+{
+	sJsonArena_* arena = &job->arenas[worker];
+	sAllocator arenaAllocator = { _arena_request_memory, _arena_return_memory, arena };
+	sJsonReader_ reader{}; // scratch reused for every record of this worker
+
+	for (int chunk = job->nextChunk.fetch_add(1); chunk < job->chunkCount; chunk = job->nextChunk.fetch_add(1))
+	{
+		const char* line = job->data + job->chunkStarts[chunk];
+		const char* chunkEnd = job->data + job->chunkStarts[chunk + 1];
+		while (line < chunkEnd)
+		{
+			const char* lineEnd = (const char*)memchr(line, '\n', (size_t)(chunkEnd - line));
+			if (lineEnd == nullptr)
+				lineEnd = chunkEnd;
+
+			const char* first = line;
+			while (first < lineEnd && (*first == ' ' || *first == '\t' || *first == '\r'))
+				first++;
+			if (first < lineEnd) // not blank
+			{
+				sJsonObject* record = _load_json(&reader, (char*)line, (size_t)(lineEnd - line), &arenaAllocator, 0);
+				if (record == nullptr)
+					job->chunkErrors[chunk]++;
+				if (job->callback)
+				{
+					job->callback(job->userData, record, (size_t)(line - job->data));
+					_arena_rewind(arena);
+				}
+				else if (!job->chunkRecords[chunk].push_back(record) && record)
+					job->chunkErrors[chunk]++; // out of memory, the record is dropped
+			}
+			line = lineEnd + 1;
+		}
+	}
+
+	_release_reader(&reader);
+}
+
+// splits the input at line boundaries & runs the workers, arenas are returned in batch mode
+static bool
+_run_ndjson(const char* data, size_t size, int threadCount, sJsonRecordFunc callback, void* userData, sJsonBatch* batch)
+{
+	if (threadCount <= 0)
+		threadCount = (int)std::thread::hardware_concurrency();
+	if (threadCount <= 0)
+		threadCount = 1;
+
+	// several chunks per worker so uneven lines balance out
+	int chunkCount = threadCount * 8;
+	if ((size_t)chunkCount > size / 4096u + 1u)
+		chunkCount = (int)(size / 4096u) + 1;
+
+	sJsonNdjsonJob_ job;
+	job.data = data;
+	job.chunkCount = chunkCount;
+	job.nextChunk = 0;
+	job.callback = callback;
+	job.userData = userData;
+	job.chunkStarts = (size_t*)S_JSON_ALLOC(sizeof(size_t) * (size_t)(chunkCount + 1));
+	job.chunkErrors = (size_t*)S_JSON_ALLOC(sizeof(size_t) * (size_t)chunkCount);
+	job.arenas = (sJsonArena_*)S_JSON_ALLOC(sizeof(sJsonArena_) * (size_t)threadCount);
+	job.chunkRecords = callback ? nullptr : (sJsonVector_<sJsonObject*>*)S_JSON_ALLOC(sizeof(sJsonVector_<sJsonObject*>) * (size_t)chunkCount);
+	std::thread* workers = (std::thread*)S_JSON_ALLOC(sizeof(std::thread) * (size_t)threadCount);
+	if (!job.chunkStarts || !job.chunkErrors || !job.arenas || (!callback && !job.chunkRecords) || !workers)
+	{
+		if (job.chunkStarts)  S_JSON_FREE(job.chunkStarts);
+		if (job.chunkErrors)  S_JSON_FREE(job.chunkErrors);
+		if (job.arenas)       S_JSON_FREE(job.arenas);
+		if (job.chunkRecords) S_JSON_FREE(job.chunkRecords);
+		if (workers)          S_JSON_FREE(workers);
+		return false;
+	}
+	memset(job.chunkErrors, 0, sizeof(size_t) * (size_t)chunkCount);
+	memset(job.arenas, 0, sizeof(sJsonArena_) * (size_t)threadCount);
+	for (int i = 0; i < chunkCount && job.chunkRecords; i++)
+		new (&job.chunkRecords[i]) sJsonVector_<sJsonObject*>();
+
+	job.chunkStarts[0] = 0u;
+	for (int i = 1; i < chunkCount; i++)
+	{
+		size_t start = size / (size_t)chunkCount * (size_t)i;
+		if (start < job.chunkStarts[i - 1])
+			start = job.chunkStarts[i - 1];
+		const char* newline = start < size ? (const char*)memchr(data + start, '\n', size - start) : nullptr;
+		job.chunkStarts[i] = newline ? (size_t)(newline - data) + 1u : size;
+	}
+	job.chunkStarts[chunkCount] = size;
+
+	for (int i = 1; i < threadCount; i++)
+		new (&workers[i]) std::thread(_ndjson_worker, &job, i);
+	_ndjson_worker(&job, 0);
+	for (int i = 1; i < threadCount; i++)
+	{
+		workers[i].join();
+		workers[i].~thread();
+	}
+	S_JSON_FREE(workers);
+
+	size_t errors = 0u;
+	size_t records = 0u;
+	for (int i = 0; i < chunkCount; i++)
+	{
+		errors += job.chunkErrors[i];
+		records += job.chunkRecords ? (size_t)job.chunkRecords[i].size : 0u;
+	}
+
+	if (batch)
+	{
+		batch->records = records ? (sJsonObject**)S_JSON_ALLOC(sizeof(sJsonObject*) * records) : nullptr;
+		batch->recordCount = 0u;
+		batch->errorCount = errors;
+		if (records && batch->records == nullptr) // out of memory, the records are dropped
+			batch->errorCount += records;
+		for (int i = 0; i < chunkCount; i++)
+		{
+			if (batch->records && job.chunkRecords[i].size > 0)
+			{
+				memcpy(batch->records + batch->recordCount, job.chunkRecords[i].data, sizeof(sJsonObject*) * (size_t)job.chunkRecords[i].size);
+				batch->recordCount += (size_t)job.chunkRecords[i].size;
+			}
+			job.chunkRecords[i].clear();
+		}
+		batch->_arenas = job.arenas;
+		batch->_arenaCount = threadCount;
+		S_JSON_FREE(job.chunkRecords);
+	}
+	else
+	{
+		for (int i = 0; i < threadCount; i++)
+			_arena_free(&job.arenas[i]);
+		S_JSON_FREE(job.arenas);
+	}
+	S_JSON_FREE(job.chunkStarts);
+	S_JSON_FREE(job.chunkErrors);
+	return true;
+}
+
+bool
+Semper::load_ndjson(const char* data, size_t size, sJsonBatch* batch, int threadCount)
+{
+	memset(batch, 0, sizeof(sJsonBatch));
+	return _run_ndjson(data, size, threadCount, nullptr, nullptr, batch);
+}
+
+bool
+Semper::load_ndjson(const char* path, sJsonBatch* batch, int threadCount)
+{
+	memset(batch, 0, sizeof(sJsonBatch));
+	sJsonMappedFile_ file;
+	if (!_map_file(path, &file))
+		return false;
+	bool result = _run_ndjson(file.data, file.size, threadCount, nullptr, nullptr, batch); // records are copies, the file can go
+	_unmap_file(&file);
+	return result;
+}
+
+void
+Semper::free_ndjson(sJsonBatch* batch)
+{
+	sJsonArena_* arenas = (sJsonArena_*)batch->_arenas;
+	for (int i = 0; i < batch->_arenaCount; i++)
+		_arena_free(&arenas[i]);
+	if (arenas)
+		S_JSON_FREE(arenas);
+	if (batch->records)
+		S_JSON_FREE(batch->records);
+	memset(batch, 0, sizeof(sJsonBatch));
+}
+
+bool
+Semper::for_each_ndjson(const char* data, size_t size, sJsonRecordFunc callback, void* userData, int threadCount)
+{
+	S_JSON_ASSERT(callback);
+	return _run_ndjson(data, size, threadCount, callback, userData, nullptr);
+}
+
+bool
+Semper::for_each_ndjson(const char* path, sJsonRecordFunc callback, void* userData, int threadCount)
+{
+	S_JSON_ASSERT(callback);
+	sJsonMappedFile_ file;
+	if (!_map_file(path, &file))
+		return false;
+	bool result = _run_ndjson(file.data, file.size, threadCount, callback, userData, nullptr);
+	_unmap_file(&file);
+	return result;
+}
+
+#endif // SEMPER_JSON_NDJSON
+
 #endif
@@ -11,6 +11,19 @@
    #include ...
    #define SEMPER_MEMORY_IMPLEMENTATION
    #include "sMemory.h"
+
+   You can also #define SEMPER_MEMORY_PROFILE to track allocation stats
+   (per allocator, per callsite, size histograms & high-water marks).
+   Semper::allocate_memory then prefixes each block with its size, so only
+   release it with Semper::free_memory.
+   SEMPER_MEMORY_PROFILE adds a stats member to every allocator, so it must be
+   defined the same way in *every* file that includes this header (i.e.
+   project-wide on the compiler command line), otherwise the allocator
+   layouts won't match between translation units.
+
+   #define SEMPER_MEMORY_BENCHMARK (with the implementation) to compile
+   Semper::run_memory_benchmark, which replays allocation traces against
+   every allocator & malloc (build with NDEBUG for meaningful numbers).
 */
 
 #ifndef SEMPER_MEMORY_H
@@ -32,7 +45,30 @@
 #define S_MEMORY_FREE(x) Semper::free_memory(x)
 #endif
 
+#ifndef S_MEMORY_PROFILE_MAX_ALLOCATORS
+#define S_MEMORY_PROFILE_MAX_ALLOCATORS 64 // allocators tracked at once (SEMPER_MEMORY_PROFILE)
+#endif
+
+#ifndef S_MEMORY_PROFILE_MAX_CALLSITES
+#define S_MEMORY_PROFILE_MAX_CALLSITES 1024 // unique __FILE__/__LINE__ pairs tracked (SEMPER_MEMORY_PROFILE)
+#endif
+
+#define S_MEMORY_PROFILE_HISTOGRAM_BUCKETS 32 // bucket i counts requests of [2^i, 2^(i+1)) bytes
+
+#ifndef S_FRAME_RING_MAX_FRAMES
+#define S_FRAME_RING_MAX_FRAMES 8 // most frames a sFrameRingAllocator keeps in flight
+#endif
+
+#ifndef S_MEMORY_HUGE_PAGE_SIZE
+#define S_MEMORY_HUGE_PAGE_SIZE 2097152 // alignment of S_PAGE_FLAGS_HUGE_PAGES blocks (2MB transparent huge pages)
+#endif
+
+#ifndef S_MEMORY_DEFAULT_ALIGNMENT
+#define S_MEMORY_DEFAULT_ALIGNMENT 16 // alignment of buffers requested from a parent allocator
+#endif
+
 #include <stddef.h>  // size_t
+#include <stdint.h>  // uint64_t
 
 //-----------------------------------------------------------------------------
 // [SECTION] Forward declarations and basic types
@@ -43,15 +79,40 @@ struct sMemoryBlock;
 struct sLinearAllocator;
 struct sStackAllocator;
 struct sStackAllocatorHeader;
+struct sStackAllocatorMarker;
+struct sDoubleStackAllocator;
+struct sFrameRingAllocator;
 struct sPoolAllocator;
 struct sPoolAllocatorNode;
+struct sBitmapPoolAllocator;
 struct sGeneralLLAllocatorHeader;
 struct sGeneralLLAllocatorNode;
 struct sGeneralLLAllocator;
+struct sAllocatorStats;
+struct sAllocationCallsite;
 
 // enums/flags
 typedef int sAllocatorType;            // -> enum sAllocatorType_
 typedef int sAllocatorPlacementPolicy; // -> enum sAllocatorPlacementPolicy_
+typedef int sMemoryProfileFormat;      // -> enum sMemoryProfileFormat_
+typedef int sPageFlags;                // -> enum sPageFlags_
+
+//-----------------------------------------------------------------------------
+// [SECTION] Allocator interface (shared by Semper libraries)
+//-----------------------------------------------------------------------------
+
+#ifndef SEMPER_ALLOCATOR_INTERFACE
+#define SEMPER_ALLOCATOR_INTERFACE
+typedef void* (*sAllocatorRequestFunc)(void* userData, size_t size, size_t alignment);
+typedef void  (*sAllocatorReturnFunc) (void* userData, void* ptr);
+
+struct sAllocator
+{
+    sAllocatorRequestFunc request_memory; // returns nullptr on failure
+    sAllocatorReturnFunc  return_memory;  // may be a no-op (i.e. linear allocators)
+    void*                 userData;       // passed back to the functions above
+};
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] Semper end-user API functions
@@ -59,12 +120,29 @@ typedef int sAllocatorPlacementPolicy; // -> enum sAllocatorPlacementPolicy_
 
 namespace Semper
 {
-    int    get_active_allocations();
-    void*  allocate_memory(size_t size);
-    void   free_memory    (void* ptr);
-    size_t get_next_power_of_2(size_t n);
+    int        get_active_allocations();
+    void*      allocate_memory(size_t size);
+    void       free_memory    (void* ptr);
+    size_t     get_next_power_of_2(size_t n);
+    sAllocator get_default_allocator(); // S_MEMORY_ALLOC/S_MEMORY_FREE
+    sAllocator get_page_allocator(sPageFlags flags); // mmap backed on linux, falls back to S_MEMORY_ALLOC (meant for large arena buffers)
+
+    // profiling (no-ops unless SEMPER_MEMORY_PROFILE is defined)
+    void             profile_callsite(const char* file, int line); // attributes the next request (use S_MEMORY_REQUEST)
+    void*            profile_callsite_end(void* result);           // drops the callsite if the request failed (use S_MEMORY_REQUEST)
+    void             reset_memory_profile();
+    bool             dump_memory_profile(const char* file, sMemoryProfileFormat format); // allocators over external memory are not included
+    sAllocatorStats* get_default_allocator_stats(); // S_MEMORY_ALLOC/S_MEMORY_FREE traffic
 }
 
+// wrap a request to attribute it to the calling __FILE__/__LINE__
+//   i.e. void* ptr = S_MEMORY_REQUEST(allocator.request_memory(64));
+#ifdef SEMPER_MEMORY_PROFILE
+#define S_MEMORY_REQUEST(call) (Semper::profile_callsite(__FILE__, __LINE__), Semper::profile_callsite_end(call))
+#else
+#define S_MEMORY_REQUEST(call) (call)
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Enums
 //-----------------------------------------------------------------------------
@@ -78,7 +156,46 @@ enum sAllocatorType_
     S_STACK_ALLOCATOR,      // Semper Stack Allocator
     S_POOL_ALLOCATOR,       // Semper Pool Allocator
     S_GENERAL_LL_ALLOCATOR, // Semper General Purpose Allocator (using linked list)
-    S_GENERAL_RB_ALLOCATOR  // Semper General Purpose Allocator (using red-black binary tree)
+    S_GENERAL_RB_ALLOCATOR, // Semper General Purpose Allocator (using red-black binary tree)
+    S_DOUBLE_STACK_ALLOCATOR, // Semper Double-Ended Stack Allocator
+    S_FRAME_RING_ALLOCATOR, // Semper Frame Ring Allocator
+    S_BITMAP_POOL_ALLOCATOR, // Semper Pool Allocator (bitmap tracked)
+    S_CUSTOM_ALLOCATOR      // user provided sAllocator interface
+};
+
+enum sPageFlags_
+{
+    S_PAGE_FLAGS_NONE       = 0,
+    S_PAGE_FLAGS_PREFAULT   = 1 << 0, // fault pages in up front (MAP_POPULATE, or touching each page)
+    S_PAGE_FLAGS_HUGE_PAGES = 1 << 1  // 2MB aligned & madvise(MADV_HUGEPAGE)
+};
+
+enum sMemoryProfileFormat_
+{
+    S_MEMORY_PROFILE_FORMAT_JSON,
+    S_MEMORY_PROFILE_FORMAT_CSV
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Profiling
+//-----------------------------------------------------------------------------
+
+struct sAllocatorStats
+{
+    const char* name;            // optional, used in dumps (set after initialize)
+    size_t      requestCount;    // successful requests
+    size_t      returnCount;     // individual returns (resets/markers not counted)
+    size_t      bytesRequested;  // total bytes requested (bytes)
+    size_t      peakBytesInUse;  // high-water mark incl. padding & headers (bytes)
+    size_t      histogram[S_MEMORY_PROFILE_HISTOGRAM_BUCKETS];
+};
+
+struct sAllocationCallsite
+{
+    const char* file;
+    int         line;
+    size_t      requestCount;
+    size_t      bytesRequested; // (bytes)
 };
 
 //-----------------------------------------------------------------------------
@@ -90,15 +207,22 @@ struct sLinearAllocator
     sAllocatorType type;
     sAllocatorType parentType;
     void*          parentAllocator; // for freeing
+    sAllocator     parent;          // interface used to request & return buffer
     unsigned char* buffer;
     size_t         bufferSize;    // size (bytes)
     size_t         currentOffset; // current ptr offset (bytes)
     bool           autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
 
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
     void initialize(size_t size, bool autoAlignment=true);                  // creates allocator & allocates memory buffer
     void initialize(size_t size, void* allocator, bool autoAlignment=true); // creates allocator & allocates memory buffer
     void initialize(void* memory, size_t size, bool autoAlignment=true);    // creates allocator to manage memory
+    void initialize(size_t size, sAllocator allocator, bool autoAlignment=true); // creates allocator & requests memory buffer from interface
 
+    sAllocator   get_allocator();                                       // return_memory is a no-op (use reset_allocator)
     void         free_memory();                                         // free allocators memory
     void*        request_memory        (size_t size);                   // returns nullptr on failure
     void*        request_aligned_memory(size_t size, size_t alignment); // returns nullptr on failure
@@ -115,27 +239,133 @@ struct sStackAllocatorHeader
     size_t ID;   // block ID (error checking)
 };
 
+struct sStackAllocatorMarker
+{
+    size_t offset; // ptr offset at time of marking (bytes)
+    size_t ID;     // block ID at time of marking
+};
+
 struct sStackAllocator
 {
     sAllocatorType type;
     sAllocatorType parentType;
     void*          parentAllocator; // for freeing
+    sAllocator     parent;          // interface used to request & return buffer
     unsigned char* buffer;
     size_t         bufferSize;    // size (bytes)
     size_t         currentOffset; // current ptr offset (bytes)
     size_t         currentID;     // current block ID (error checking)
     bool           autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
 
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
     // stack allocator
     void        initialize(size_t size, bool autoAlignment=true);                  // creates allocator & allocates memory buffer
     void        initialize(size_t size, void* allocator, bool autoAlignment=true); // creates allocator and allocates memory buffer
     void        initialize(void* memory, size_t size, bool autoAlignment=true);    // creates allocator to manage memory
+    void        initialize(size_t size, sAllocator allocator, bool autoAlignment=true); // creates allocator & requests memory buffer from interface
+    sAllocator  get_allocator();                                                   // return_memory must be called in reverse order
     void        free_memory();                                                     // frees allocators memory
     void*       request_memory(size_t size);                                       // returns nullptr on failure
     void*       request_aligned_memory(size_t size, size_t alignment);             // returns nullptr on failure
     bool        return_memory(void* ptr);                                          // sets the offset back (must be in reverse order)
     inline void reset_allocator (){ currentOffset = 0u; currentID = 0u;}           // returns offset to 0
 
+    // marker api (no per-allocation header, release with free_to_marker)
+    void*                        request_raw_memory        (size_t size);                   // returns nullptr on failure
+    void*                        request_raw_aligned_memory(size_t size, size_t alignment); // returns nullptr on failure
+    inline sStackAllocatorMarker get_marker(){ return {currentOffset, currentID};}
+    void                         free_to_marker(sStackAllocatorMarker marker);              // releases everything allocated after marker
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Double-Ended Stack Allocator
+//-----------------------------------------------------------------------------
+
+// Allocates from both ends of a single buffer (i.e. long-lived data from the
+// lower end, transient data from the upper end). Allocations carry no header
+// and are released with markers.
+struct sDoubleStackAllocator
+{
+    sAllocatorType type;
+    sAllocatorType parentType;
+    void*          parentAllocator; // for freeing
+    sAllocator     parent;          // interface used to request & return buffer
+    unsigned char* buffer;
+    size_t         bufferSize;  // size (bytes)
+    size_t         lowerOffset; // first free byte from the bottom (bytes)
+    size_t         upperOffset; // first used byte from the top (bytes)
+    bool           autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
+
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
+    void          initialize(size_t size, bool autoAlignment=true);                  // creates allocator & allocates memory buffer
+    void          initialize(size_t size, void* allocator, bool autoAlignment=true); // creates allocator and allocates memory buffer
+    void          initialize(void* memory, size_t size, bool autoAlignment=true);    // creates allocator to manage memory
+    void          initialize(size_t size, sAllocator allocator, bool autoAlignment=true); // creates allocator & requests memory buffer from interface
+    sAllocator    get_allocator();                                                   // allocates from the lower end, return_memory is a no-op
+    void          free_memory();                                                     // frees allocators memory
+    void*         request_lower_memory        (size_t size);                         // returns nullptr on failure
+    void*         request_lower_aligned_memory(size_t size, size_t alignment);       // returns nullptr on failure
+    void*         request_upper_memory        (size_t size);                         // returns nullptr on failure
+    void*         request_upper_aligned_memory(size_t size, size_t alignment);       // returns nullptr on failure
+    void          free_lower_to_marker(size_t marker);                               // releases lower allocations made after marker
+    void          free_upper_to_marker(size_t marker);                               // releases upper allocations made after marker
+    inline size_t get_lower_marker() { return lowerOffset;}
+    inline size_t get_upper_marker() { return upperOffset;}
+    inline size_t get_free_size()    { return upperOffset - lowerOffset;}
+    inline void   reset_lower()      { lowerOffset = 0u;}
+    inline void   reset_upper()      { upperOffset = bufferSize;}
+    inline void   reset_allocator()  { lowerOffset = 0u; upperOffset = bufferSize;}
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Frame Ring Allocator
+//-----------------------------------------------------------------------------
+
+// Allocations are tagged with the current frame index. Frames retire in
+// order (oldest first) and a retired frame's region is reclaimed in O(1).
+// With framesInFlight = k, ending frame N retires frame N-k+1 automatically.
+
+struct sFrameRingAllocator
+{
+    sAllocatorType type;
+    sAllocatorType parentType;
+    void*          parentAllocator; // for freeing
+    sAllocator     parent;          // interface used to request & return buffer
+    unsigned char* buffer;
+    size_t         bufferSize;      // size (bytes)
+    size_t         head;            // virtual offset of next request (bytes, wraps modulo bufferSize)
+    size_t         tail;            // virtual offset where the oldest live frame starts (bytes)
+    size_t         currentFrame;    // frame index new requests are tagged with
+    size_t         oldestFrame;     // oldest frame not yet retired
+    size_t         framesInFlight;  // frames kept alive by end_frame (i.e. 2 or 3 for double/triple buffering)
+    size_t         frameStarts[S_FRAME_RING_MAX_FRAMES]; // virtual offset each live frame starts at
+    bool           autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
+
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
+    void initialize(size_t size, size_t frames, bool autoAlignment=true);                  // creates allocator & allocates memory buffer
+    void initialize(size_t size, size_t frames, void* allocator, bool autoAlignment=true); // creates allocator & allocates memory buffer
+    void initialize(void* memory, size_t size, size_t frames, bool autoAlignment=true);    // creates allocator to manage memory
+    void initialize(size_t size, size_t frames, sAllocator allocator, bool autoAlignment=true); // creates allocator & requests memory buffer from interface
+
+    sAllocator    get_allocator();                                       // return_memory is a no-op (use retire_frame)
+    void          free_memory();                                         // free allocators memory
+    void*         request_memory        (size_t size);                   // tagged with currentFrame, returns nullptr on failure
+    void*         request_aligned_memory(size_t size, size_t alignment); // tagged with currentFrame, returns nullptr on failure
+    size_t        end_frame();                                           // starts next frame & retires beyond framesInFlight, returns ended frame
+    void          retire_frame(size_t frame);                            // reclaims frame & all older frames (O(1))
+    void          reset_allocator();                                     // retires everything, frame indices keep counting
+    inline size_t get_frame()     { return currentFrame;}
+    inline size_t get_used_size() { return head - tail;}
+    inline size_t get_free_size() { return bufferSize - (head - tail);}
 };
 
 //-----------------------------------------------------------------------------
@@ -152,6 +382,7 @@ struct sPoolAllocator
     sAllocatorType      type;
     sAllocatorType      parentType;
     void*               parentAllocator; // for freeing
+    sAllocator          parent;          // interface used to request & return buffer
     unsigned char*      buffer;
     size_t              bufferSize;      // size (bytes)
     size_t              chunkSize;       // item size + padding for alignment (bytes)
@@ -160,14 +391,69 @@ struct sPoolAllocator
     sPoolAllocatorNode* head;            // start of freelist
     bool                autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
 
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
     void  initialize(size_t itemCount, size_t itemSize, size_t alignment, bool autoAlignment=true);                            // creates allocator & allocates memory buffer
     void  initialize(size_t itemCount, size_t itemSize, size_t alignment, void* allocator, bool autoAlignment=true);           // creates allocator and allocates memory buffer
     void  initialize(size_t itemCount, size_t itemSize, size_t alignment, void* memory, size_t size, bool autoAlignment=true); // creates allocator to manage memory
+    void  initialize(size_t itemCount, size_t itemSize, size_t alignment, sAllocator allocator, bool autoAlignment=true);      // creates allocator & requests memory buffer from interface
+    sAllocator get_allocator(); // requests must fit in chunkSize
     void  free_memory();            // free allocators memory
     void* request_memory();         // returns nullptr on failure
     bool  return_memory(void* ptr); // returns memory to free list
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Bitmap Pool Allocator
+//-----------------------------------------------------------------------------
+
+// Pool variant tracking occupancy in a bitmap (stored after the chunks)
+// instead of an intrusive freelist. Requests take the lowest free chunk,
+// keeping live objects packed & iterable in address order.
+
+struct sBitmapPoolAllocator
+{
+    sAllocatorType type;
+    sAllocatorType parentType;
+    void*          parentAllocator; // for freeing
+    sAllocator     parent;          // interface used to request & return buffer
+    unsigned char* buffer;
+    size_t         bufferSize;      // size incl. bitmap (bytes)
+    size_t         chunkSize;       // item size + padding for alignment (bytes)
+    size_t         count;           // number of items owned by pool
+    size_t         freeItemCount;   // number of items available
+    uint64_t*      bitmap;          // bit set = chunk is live (padding bits past count are set)
+    size_t         wordCount;       // number of bitmap words
+    size_t         firstFreeWord;   // no free chunk in words before this one
+    bool           autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
+
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
+    void  initialize(size_t itemCount, size_t itemSize, size_t alignment, bool autoAlignment=true);                            // creates allocator & allocates memory buffer
+    void  initialize(size_t itemCount, size_t itemSize, size_t alignment, void* allocator, bool autoAlignment=true);           // creates allocator and allocates memory buffer
+    void  initialize(size_t itemCount, size_t itemSize, size_t alignment, void* memory, size_t size, bool autoAlignment=true); // creates allocator to manage memory (see get_required_size)
+    void  initialize(size_t itemCount, size_t itemSize, size_t alignment, sAllocator allocator, bool autoAlignment=true);      // creates allocator & requests memory buffer from interface
+    sAllocator get_allocator(); // requests must fit in chunkSize
+    void  free_memory();            // free allocators memory
+    void* request_memory();         // lowest free chunk, returns nullptr on failure
+    bool  return_memory(void* ptr); // clears chunk's bit
+    void  reset_allocator();        // returns every chunk
+
+    bool  is_live(void* ptr);
+    void* get_first_live();          // lowest live chunk, nullptr if empty
+    void* get_next_live(void* ptr);  // next live chunk in address order, nullptr at the end
+    inline size_t get_index(void* ptr)   { return ((unsigned char*)ptr - buffer) / chunkSize;}
+    inline void*  get_chunk(size_t index){ return &buffer[index * chunkSize];}
+    inline size_t get_live_count()       { return count - freeItemCount;}
+    inline float  get_occupancy()        { return count ? (float)(count - freeItemCount) / (float)count : 0.0f;}
+
+    static size_t get_required_size(size_t itemCount, size_t itemSize, size_t alignment); // chunks + bitmap (bytes, autoAlignment)
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] General Allocator (Freelist using linked list)
 //-----------------------------------------------------------------------------
@@ -196,6 +482,7 @@ struct sGeneralLLAllocator
     sAllocatorType            type;
     sAllocatorType            parentType;
     void*                     parentAllocator; // for freeing
+    sAllocator                parent;          // interface used to request & return buffer
     void*                     buffer;
     size_t                    bufferSize;
     size_t                    used;
@@ -203,15 +490,61 @@ struct sGeneralLLAllocator
     sAllocatorPlacementPolicy placementPolicy;
     bool                      autoCorrectAlignment; // automatically increases requested alignment to nearest power of 2
 
+    #if defined(SEMPER_MEMORY_PROFILE)
+    sAllocatorStats stats;
+    #endif
+
     void  initialize(size_t size, sAllocatorPlacementPolicy policy, bool autoAlignment=true);
     void  initialize(size_t size, sAllocatorPlacementPolicy policy, void* allocator, bool autoAlignment=true); // creates allocator and allocates memory buffer
     void  initialize(void* memory, sAllocatorPlacementPolicy policy, size_t size, bool autoAlignment=true);    // creates allocator to manage memory
+    void  initialize(size_t size, sAllocatorPlacementPolicy policy, sAllocator allocator, bool autoAlignment=true); // creates allocator & requests memory buffer from interface
+    sAllocator get_allocator();
     void  free_memory();
     void* request_memory(size_t size);
     void* request_aligned_memory(size_t size, size_t alignment);
     void  return_memory(void* ptr);
+    float get_fragmentation(); // 1 - largest free block / total free (0 -> no fragmentation)
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Benchmark
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_MEMORY_BENCHMARK)
+struct sMemoryBenchmarkResult
+{
+    const char* allocator;
+    const char* trace;
+    size_t      operations;    // requests + returns + resets
+    size_t      failures;      // requests returning nullptr
+    double      seconds;
+    double      opsPerSecond;
+    double      p50;           // per operation latency (ns)
+    double      p99;           // per operation latency (ns)
+    double      p999;          // per operation latency (ns)
+    double      max;           // per operation latency (ns)
+    float       fragmentation; // free-list fragmentation at end of trace (-1 if n/a)
 };
 
+struct sPageBenchmarkResult
+{
+    const char* backend;
+    double      initializeSeconds; // arena initialize (incl. prefaulting)
+    double      firstTouchSeconds; // writing one byte per page afterwards
+    double      randomAccessNs;    // per random 8 byte read-modify-write
+};
+
+namespace Semper
+{
+    int  run_memory_benchmark(sMemoryBenchmarkResult* results, int maxResults, size_t operations=200000u); // returns result count
+    void print_memory_benchmark(const sMemoryBenchmarkResult* results, int count);
+
+    // linear arena on default vs page allocator backends (TLB heavy random access)
+    int  run_page_benchmark(sPageBenchmarkResult* results, int maxResults, size_t arenaSize=(size_t)1u << 30, size_t accesses=20000000u); // returns result count
+    void print_page_benchmark(const sPageBenchmarkResult* results, int count);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] General Allocator (Freelist using red-black binary tree)
 //-----------------------------------------------------------------------------
@@ -268,8 +601,136 @@ _calc_padding_with_header(uintptr_t ptr, uintptr_t alignment, size_t header_size
 	return (size_t)padding;
 }
 
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward64
+static inline unsigned int
+_count_trailing_zeros(uint64_t x) // x != 0
+{
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (unsigned int)index;
+}
+#else
+static inline unsigned int
+_count_trailing_zeros(uint64_t x) // x != 0
+{
+    return (unsigned int)__builtin_ctzll(x);
+}
+#endif
+
 static int g_semperMetricsActiveAllocations = 0;
 
+//-----------------------------------------------------------------------------
+// [SECTION] Profiling
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_MEMORY_PROFILE)
+
+#include <stdio.h> // fopen, fprintf
+
+// profiling state is not synchronized (same as the allocators themselves)
+static void*               g_semperProfileAllocators[S_MEMORY_PROFILE_MAX_ALLOCATORS];
+static sAllocationCallsite g_semperProfileCallsites[S_MEMORY_PROFILE_MAX_CALLSITES];
+static sAllocatorStats     g_semperProfileDefaultStats;
+static const char*         g_semperProfilePendingFile = nullptr;
+static int                 g_semperProfilePendingLine = 0;
+static size_t              g_semperProfileDefaultBytesInUse = 0u;
+
+// Semper::allocate_memory stores the size in front of each block so free_memory can keep bytes in use
+#define S_PROFILE_DEFAULT_HEADER_SIZE_ alignof(max_align_t)
+
+static inline int
+_profile_size_class(size_t size)
+{
+    int bucket = 0;
+    while (size >>= 1) bucket++;
+    return bucket < S_MEMORY_PROFILE_HISTOGRAM_BUCKETS ? bucket : S_MEMORY_PROFILE_HISTOGRAM_BUCKETS - 1;
+}
+
+static void
+_profile_request(sAllocatorStats* stats, size_t size, size_t bytesInUse)
+{
+    stats->requestCount++;
+    stats->bytesRequested += size;
+    stats->histogram[_profile_size_class(size)]++;
+    if(bytesInUse > stats->peakBytesInUse) stats->peakBytesInUse = bytesInUse;
+
+    if(g_semperProfilePendingFile == nullptr)
+        return;
+
+    // open addressing on (file ptr, line); __FILE__ literals compare by address
+    size_t index = (((size_t)g_semperProfilePendingFile >> 3) * 31u + (size_t)g_semperProfilePendingLine) % S_MEMORY_PROFILE_MAX_CALLSITES;
+    for(size_t i = 0; i < S_MEMORY_PROFILE_MAX_CALLSITES; i++)
+    {
+        sAllocationCallsite& callsite = g_semperProfileCallsites[index];
+        if(callsite.file == nullptr)
+        {
+            callsite.file = g_semperProfilePendingFile;
+            callsite.line = g_semperProfilePendingLine;
+        }
+        if(callsite.file == g_semperProfilePendingFile && callsite.line == g_semperProfilePendingLine)
+        {
+            callsite.requestCount++;
+            callsite.bytesRequested += size;
+            break;
+        }
+        index = (index + 1) % S_MEMORY_PROFILE_MAX_CALLSITES;
+    }
+    g_semperProfilePendingFile = nullptr;
+}
+
+static void
+_profile_register(void* allocator, sAllocatorStats* stats)
+{
+    memset(stats, 0, sizeof(sAllocatorStats));
+    for(int i = 0; i < S_MEMORY_PROFILE_MAX_ALLOCATORS; i++)
+    {
+        if(g_semperProfileAllocators[i] == nullptr || g_semperProfileAllocators[i] == allocator)
+        {
+            g_semperProfileAllocators[i] = allocator;
+            return;
+        }
+    }
+    S_MEMORY_ASSERT(false && "Increase S_MEMORY_PROFILE_MAX_ALLOCATORS.");
+}
+
+static void
+_profile_unregister(void* allocator)
+{
+    for(int i = 0; i < S_MEMORY_PROFILE_MAX_ALLOCATORS; i++)
+    {
+        if(g_semperProfileAllocators[i] == allocator)
+        {
+            g_semperProfileAllocators[i] = nullptr;
+            return;
+        }
+    }
+}
+
+// external memory can go away without free_memory, so those allocators keep stats but are never tracked
+static void
+_profile_reset(void* allocator, sAllocatorStats* stats)
+{
+    memset(stats, 0, sizeof(sAllocatorStats));
+    _profile_unregister(allocator);
+}
+
+#define S_PROFILE_REQUEST_(statsPtr, size, bytesInUse) _profile_request(statsPtr, size, bytesInUse)
+#define S_PROFILE_RETURN_(statsPtr) (statsPtr)->returnCount++
+#define S_PROFILE_REGISTER_(allocator) _profile_register(allocator, &(allocator)->stats)
+#define S_PROFILE_UNREGISTER_(allocator) _profile_unregister(allocator)
+#define S_PROFILE_RESET_(allocator) _profile_reset(allocator, &(allocator)->stats)
+
+#else
+
+#define S_PROFILE_REQUEST_(statsPtr, size, bytesInUse) ((void)0)
+#define S_PROFILE_RETURN_(statsPtr) ((void)0)
+#define S_PROFILE_REGISTER_(allocator) ((void)0)
+#define S_PROFILE_UNREGISTER_(allocator) ((void)0)
+#define S_PROFILE_RESET_(allocator) ((void)0)
+
+#endif // SEMPER_MEMORY_PROFILE
+
 int
 Semper::get_active_allocations()
 {
@@ -280,16 +741,206 @@ void*
 Semper::allocate_memory(size_t size)
 {
     g_semperMetricsActiveAllocations++;
+#if defined(SEMPER_MEMORY_PROFILE)
+    unsigned char* allocation = (unsigned char*)malloc(size + S_PROFILE_DEFAULT_HEADER_SIZE_);
+    if(allocation == nullptr)
+        return nullptr;
+    *(size_t*)allocation = size;
+    g_semperProfileDefaultBytesInUse += size;
+    S_PROFILE_REQUEST_(&g_semperProfileDefaultStats, size, g_semperProfileDefaultBytesInUse);
+    return allocation + S_PROFILE_DEFAULT_HEADER_SIZE_;
+#else
     return malloc(size);
+#endif
 }
 
 void
 Semper::free_memory(void* ptr)
 {
     g_semperMetricsActiveAllocations--;
+#if defined(SEMPER_MEMORY_PROFILE)
+    if(ptr == nullptr)
+        return;
+    ptr = (unsigned char*)ptr - S_PROFILE_DEFAULT_HEADER_SIZE_;
+    g_semperProfileDefaultBytesInUse -= *(size_t*)ptr;
+    S_PROFILE_RETURN_(&g_semperProfileDefaultStats);
+#endif
     free(ptr);
 }
 
+// over-allocates so any alignment can be met, the start of the allocation is stored right before the block
+static void*
+_default_request_memory(void* userData, size_t size, size_t alignment)
+{
+    (void)userData;
+    if(alignment < sizeof(void*)) alignment = sizeof(void*);
+    unsigned char* allocation = (unsigned char*)S_MEMORY_ALLOC(size + alignment + sizeof(void*));
+    if(allocation == nullptr)
+        return nullptr;
+    uintptr_t block = _align_forward_uintptr((uintptr_t)allocation + sizeof(void*), alignment);
+    ((void**)block)[-1] = allocation;
+    return (void*)block;
+}
+
+static void
+_default_return_memory(void* userData, void* ptr)
+{
+    (void)userData;
+    if(ptr)
+        S_MEMORY_FREE(((void**)ptr)[-1]);
+}
+
+sAllocator
+Semper::get_default_allocator()
+{
+    sAllocator allocator{};
+    allocator.request_memory = _default_request_memory;
+    allocator.return_memory  = _default_return_memory;
+    return allocator;
+}
+
+static sAllocator
+_get_allocator_interface(void* allocator)
+{
+    S_MEMORY_ASSERT(allocator);
+    switch (*(sAllocatorType*)allocator)
+    {
+    case S_LINEAR_ALLOCATOR:       return ((sLinearAllocator*)allocator)->get_allocator();
+    case S_STACK_ALLOCATOR:        return ((sStackAllocator*)allocator)->get_allocator();
+    case S_DOUBLE_STACK_ALLOCATOR: return ((sDoubleStackAllocator*)allocator)->get_allocator();
+    case S_FRAME_RING_ALLOCATOR:   return ((sFrameRingAllocator*)allocator)->get_allocator();
+    case S_POOL_ALLOCATOR:         return ((sPoolAllocator*)allocator)->get_allocator();
+    case S_BITMAP_POOL_ALLOCATOR:  return ((sBitmapPoolAllocator*)allocator)->get_allocator();
+    case S_GENERAL_LL_ALLOCATOR:   return ((sGeneralLLAllocator*)allocator)->get_allocator();
+    default:
+        S_MEMORY_ASSERT(false && "Parent allocator type not supported");
+        break;
+    }
+    return {};
+}
+
+static void*
+_request_buffer(sAllocator* parent, size_t size, size_t alignment)
+{
+    S_MEMORY_ASSERT(parent->request_memory && "Parent allocator has no request_memory function.");
+    if(parent->request_memory == nullptr)
+        return nullptr;
+    return parent->request_memory(parent->userData, size, alignment);
+}
+
+static void
+_return_buffer(sAllocator* parent, void* buffer)
+{
+    if(parent->return_memory)
+        parent->return_memory(parent->userData, buffer);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Page allocator
+//-----------------------------------------------------------------------------
+
+#if defined(__linux__)
+#include <sys/mman.h> // mmap, madvise
+#include <unistd.h>   // sysconf
+#endif
+
+struct sPageHeader_ // stored right before each block
+{
+    void*  base;       // start of mapping/allocation
+    size_t mappedSize; // (bytes), 0 if from S_MEMORY_ALLOC
+};
+
+static void
+_page_touch(void* memory, size_t size, size_t pageSize)
+{
+    volatile unsigned char* bytes = (volatile unsigned char*)memory;
+    for (size_t offset = 0u; offset < size; offset += pageSize)
+        bytes[offset] = 0u;
+}
+
+static void*
+_page_request_memory(void* userData, size_t size, size_t alignment)
+{
+    sPageFlags flags = (sPageFlags)(uintptr_t)userData;
+    size_t pageSize = 4096u;
+    #if defined(__linux__)
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    #endif
+    size_t blockAlignment = (flags & S_PAGE_FLAGS_HUGE_PAGES) ? S_MEMORY_HUGE_PAGE_SIZE : pageSize;
+    if (alignment > blockAlignment) blockAlignment = Semper::get_next_power_of_2(alignment);
+    size_t blockSize = (flags & S_PAGE_FLAGS_HUGE_PAGES) ? _align_forward_size(size, S_MEMORY_HUGE_PAGE_SIZE) : size; // whole huge pages are mapped past the block
+    size_t totalSize = _align_forward_size(blockSize + sizeof(sPageHeader_) + blockAlignment, pageSize);
+
+    #if defined(__linux__)
+    int mapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #if defined(MAP_POPULATE)
+    if ((flags & S_PAGE_FLAGS_PREFAULT) && !(flags & S_PAGE_FLAGS_HUGE_PAGES)) mapFlags |= MAP_POPULATE; // huge pages are populated after madvise
+    #endif
+    void* base = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, mapFlags, -1, 0);
+    if (base != MAP_FAILED)
+    {
+        uintptr_t block = _align_forward_uintptr((uintptr_t)base + sizeof(sPageHeader_), blockAlignment);
+        if (flags & S_PAGE_FLAGS_HUGE_PAGES)
+        {
+            #if defined(MADV_HUGEPAGE)
+            madvise((void*)block, blockSize, MADV_HUGEPAGE); // ignored if THP is disabled
+            #endif
+            if (flags & S_PAGE_FLAGS_PREFAULT)
+            {
+                bool populated = false;
+                #if defined(MADV_POPULATE_WRITE)
+                populated = madvise((void*)block, _align_forward_size(size, pageSize), MADV_POPULATE_WRITE) == 0;
+                #endif
+                if (!populated) _page_touch((void*)block, size, pageSize);
+            }
+        }
+        sPageHeader_* header = (sPageHeader_*)block - 1;
+        header->base = base;
+        header->mappedSize = totalSize;
+        return (void*)block;
+    }
+    #endif
+
+    // fallback
+    void* fallbackBase = S_MEMORY_ALLOC(size + sizeof(sPageHeader_) + blockAlignment);
+    if (fallbackBase == nullptr)
+        return nullptr;
+    uintptr_t fallbackBlock = _align_forward_uintptr((uintptr_t)fallbackBase + sizeof(sPageHeader_), blockAlignment);
+    if (flags & S_PAGE_FLAGS_PREFAULT)
+        _page_touch((void*)fallbackBlock, size, pageSize);
+    sPageHeader_* fallbackHeader = (sPageHeader_*)fallbackBlock - 1;
+    fallbackHeader->base = fallbackBase;
+    fallbackHeader->mappedSize = 0u;
+    return (void*)fallbackBlock;
+}
+
+static void
+_page_return_memory(void* userData, void* ptr)
+{
+    (void)userData;
+    if (ptr == nullptr)
+        return;
+    sPageHeader_* header = (sPageHeader_*)ptr - 1;
+    #if defined(__linux__)
+    if (header->mappedSize > 0u)
+    {
+        munmap(header->base, header->mappedSize);
+        return;
+    }
+    #endif
+    S_MEMORY_FREE(header->base);
+}
+
+sAllocator
+Semper::get_page_allocator(sPageFlags flags)
+{
+    sAllocator allocator{};
+    allocator.request_memory = _page_request_memory;
+    allocator.return_memory  = _page_return_memory;
+    allocator.userData       = (void*)(uintptr_t)flags;
+    return allocator;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Linear Allocator
 //-----------------------------------------------------------------------------
@@ -302,6 +953,7 @@ _set_default_state(sLinearAllocator* allocator)
     allocator->type = S_LINEAR_ALLOCATOR;
     allocator->parentType = S_ALLOCATOR_TYPE_NONE;
     allocator->parentAllocator = nullptr;
+    allocator->parent = {};
     allocator->buffer = nullptr;
     allocator->bufferSize = 0u;
     allocator->currentOffset = 0u;
@@ -310,68 +962,48 @@ _set_default_state(sLinearAllocator* allocator)
 void
 sLinearAllocator::initialize(size_t size, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(size > 0u);
-    autoCorrectAlignment = autoAlignment;
+    initialize(size, Semper::get_default_allocator(), autoAlignment);
     parentType = S_DEFAULT_ALLOCATOR;
-    bufferSize = size;
-    buffer = (unsigned char*)S_MEMORY_ALLOC(size);
 }
 
 void
 sLinearAllocator::initialize(size_t size, void* allocator, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(size > 0u);
     S_MEMORY_ASSERT(allocator != nullptr);
-
     if (allocator == nullptr)
+    {
+        _set_default_state(this);
         return;
+    }
 
-    autoCorrectAlignment = autoAlignment;
-    parentAllocator = allocator;
-    bufferSize = size;
+    initialize(size, _get_allocator_interface(allocator), autoAlignment);
     parentType = *(sAllocatorType*)allocator;
-    switch (parentType)
-    {
-    case S_LINEAR_ALLOCATOR:
-    {
-        auto parentAllocator = (sLinearAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_STACK_ALLOCATOR:
-    {
-        auto parentAllocator = (sStackAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_POOL_ALLOCATOR:
-    {
-        auto parentAllocator = (sPoolAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_memory();
-        break;
-    }
-    case S_GENERAL_LL_ALLOCATOR:
-    {
-        auto parentAllocator = (sGeneralLLAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    default:
-        S_MEMORY_ASSERT(false && "Parent allocator type not supported");
-        break;
-    }
+    parentAllocator = allocator;
 }
 
 void
-sLinearAllocator::initialize(void* memory, size_t size, bool autoAlignment)
+sLinearAllocator::initialize(size_t size, sAllocator allocator, bool autoAlignment)
 {
     _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
     S_MEMORY_ASSERT(size > 0u);
-    S_MEMORY_ASSERT(memory != nullptr);
     autoCorrectAlignment = autoAlignment;
-    parentType = S_EXTERNAL_ALLOCATOR;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    bufferSize = size;
+    buffer = (unsigned char*)_request_buffer(&parent, size, S_MEMORY_DEFAULT_ALIGNMENT);
+}
+
+void
+sLinearAllocator::initialize(void* memory, size_t size, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(size > 0u);
+    S_MEMORY_ASSERT(memory != nullptr);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_EXTERNAL_ALLOCATOR;
     bufferSize = size;
     buffer = (unsigned char*)memory;
 }
@@ -379,41 +1011,25 @@ sLinearAllocator::initialize(void* memory, size_t size, bool autoAlignment)
 void
 sLinearAllocator::free_memory()
 {
+    S_PROFILE_UNREGISTER_(this);
     if (buffer)
-    {
-        switch (parentType)
-        {
-        case S_STACK_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sStackAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_POOL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(this->parentAllocator);
-            auto parentAllocator = (sPoolAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_GENERAL_LL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sGeneralLLAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_DEFAULT_ALLOCATOR:
-        {
-            S_MEMORY_FREE(buffer);
-            break;
-        }
-        }     
-    }
+        _return_buffer(&parent, buffer);
     _set_default_state(this);
 }
 
+static void* _linear_request_memory(void* userData, size_t size, size_t alignment) { return ((sLinearAllocator*)userData)->request_aligned_memory(size, alignment);}
+static void  _linear_return_memory (void* userData, void* ptr)                     { (void)userData; (void)ptr;}
+
+sAllocator
+sLinearAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _linear_request_memory;
+    allocator.return_memory  = _linear_return_memory;
+    return allocator;
+}
+
 void*
 sLinearAllocator::request_memory(size_t size)
 {
@@ -428,6 +1044,7 @@ sLinearAllocator::request_memory(size_t size)
     // update offset pointer
     auto memory = (byte*)buffer + currentOffset;
     currentOffset = offset; // new offset
+    S_PROFILE_REQUEST_(&stats, size, currentOffset);
     return memory;
 }
 
@@ -445,6 +1062,7 @@ sLinearAllocator::request_aligned_memory(size_t size, size_t alignment)
     {
 		void *ptr = &buffer[offset];
 		currentOffset = offset+size;
+        S_PROFILE_REQUEST_(&stats, size, currentOffset);
 
 		// Zero new memory by default
 		memset(ptr, 0, size);
@@ -467,6 +1085,7 @@ _set_default_state(sStackAllocator* allocator)
     allocator->type = S_STACK_ALLOCATOR;
     allocator->parentType = S_ALLOCATOR_TYPE_NONE;
     allocator->parentAllocator = nullptr;
+    allocator->parent = {};
     allocator->buffer = nullptr;
     allocator->bufferSize = 0u;
     allocator->currentOffset = 0u;
@@ -476,65 +1095,44 @@ _set_default_state(sStackAllocator* allocator)
 void
 sStackAllocator::initialize(size_t size, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(size > 0u);
-    autoCorrectAlignment = autoAlignment;
-    type = S_STACK_ALLOCATOR;
+    initialize(size, Semper::get_default_allocator(), autoAlignment);
     parentType = S_DEFAULT_ALLOCATOR;
-    bufferSize = size;
-    buffer = (unsigned char*)S_MEMORY_ALLOC(size);
 }
 
 void 
 sStackAllocator::initialize(size_t size, void* allocator, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(size > 0u);
     S_MEMORY_ASSERT(allocator != nullptr);
-
     if (allocator == nullptr)
+    {
+        _set_default_state(this);
         return;
+    }
 
-    autoCorrectAlignment = autoAlignment;
+    initialize(size, _get_allocator_interface(allocator), autoAlignment);
     parentType = *(sAllocatorType*)allocator;
     parentAllocator = allocator;
+}
+
+void
+sStackAllocator::initialize(size_t size, sAllocator allocator, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
+    S_MEMORY_ASSERT(size > 0u);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
     bufferSize = size;
-    switch (parentType)
-    {
-    case S_LINEAR_ALLOCATOR:
-    {
-        auto parentAllocator = (sLinearAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_STACK_ALLOCATOR:
-    {
-        auto parentAllocator = (sStackAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_POOL_ALLOCATOR:
-    {
-        auto parentAllocator = (sPoolAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_memory();
-        break;
-    }
-        case S_GENERAL_LL_ALLOCATOR:
-    {
-        auto parentAllocator = (sGeneralLLAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    default:
-        S_MEMORY_ASSERT(false && "Parent allocator type not supported");
-        break;
-    }
+    buffer = (unsigned char*)_request_buffer(&parent, size, S_MEMORY_DEFAULT_ALIGNMENT);
 }
 
 void
 sStackAllocator::initialize(void* memory, size_t size, bool autoAlignment)
 {
     _set_default_state(this);
+    S_PROFILE_RESET_(this);
     S_MEMORY_ASSERT(size > 0u);
     S_MEMORY_ASSERT(memory != nullptr);
     autoCorrectAlignment = autoAlignment;
@@ -546,43 +1144,25 @@ sStackAllocator::initialize(void* memory, size_t size, bool autoAlignment)
 void
 sStackAllocator::free_memory()
 {
+    S_PROFILE_UNREGISTER_(this);
     if (buffer)
-    {
-        switch (parentType)
-        {
-        case S_STACK_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sStackAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_POOL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sPoolAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_GENERAL_LL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sGeneralLLAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_DEFAULT_ALLOCATOR:
-        {
-            S_MEMORY_FREE(buffer);
-            break;
-        }
-        default:
-            break;
-        }
-    }
+        _return_buffer(&parent, buffer);
     _set_default_state(this);
 }
 
+static void* _stack_request_memory(void* userData, size_t size, size_t alignment) { return ((sStackAllocator*)userData)->request_aligned_memory(size, alignment);}
+static void  _stack_return_memory (void* userData, void* ptr)                     { ((sStackAllocator*)userData)->return_memory(ptr);}
+
+sAllocator
+sStackAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _stack_request_memory;
+    allocator.return_memory  = _stack_return_memory;
+    return allocator;
+}
+
 void*
 sStackAllocator::request_memory(size_t size)
 {
@@ -603,6 +1183,7 @@ sStackAllocator::request_memory(size_t size)
     // update offset pointer
     auto memory = (byte*)buffer + currentOffset + sizeof(sStackAllocatorHeader);
     currentOffset = offset; // new offset
+    S_PROFILE_REQUEST_(&stats, size, currentOffset);
     return memory;
 }
 
@@ -625,6 +1206,7 @@ sStackAllocator::request_aligned_memory(size_t size, size_t alignment)
         return nullptr;
     }
     currentOffset = offset; // new offset
+    S_PROFILE_REQUEST_(&stats, size, currentOffset);
 
     auto headerMemoryLocation = currentMemoryLocation + paddingBytes;
     auto header = (sStackAllocatorHeader*)headerMemoryLocation;
@@ -644,529 +1226,1920 @@ sStackAllocator::return_memory(void* ptr)
     {
         currentID--;
         currentOffset = currentOffset - header->size;
+        S_PROFILE_RETURN_(&stats);
         return true;
     }
     S_MEMORY_ASSERT(false && "Stack allocator requires memory to be returned in order.");
     return false;
 }
 
+void*
+sStackAllocator::request_raw_memory(size_t size)
+{
+    size_t offset = currentOffset + size;
+
+    if (offset > bufferSize) // make sure we have enough memory
+    {
+        S_MEMORY_ASSERT(false && "Stack allocator is full.");
+        return nullptr;
+    }
+
+    auto memory = (byte*)buffer + currentOffset;
+    currentOffset = offset; // new offset
+    S_PROFILE_REQUEST_(&stats, size, currentOffset);
+    return memory;
+}
+
+void*
+sStackAllocator::request_raw_aligned_memory(size_t size, size_t alignment)
+{
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    S_MEMORY_ASSERT(_is_power_of_two(alignment));
+    uintptr_t curr_ptr = (uintptr_t)buffer + (uintptr_t)currentOffset;
+    uintptr_t offset = _align_forward_uintptr(curr_ptr, alignment);
+    offset -= (uintptr_t)buffer;
+
+    if (offset+size > bufferSize)
+    {
+        S_MEMORY_ASSERT(false && "Stack allocator doesn't have enough room.");
+        return nullptr;
+    }
+    currentOffset = offset+size;
+    S_PROFILE_REQUEST_(&stats, size, currentOffset);
+    return &buffer[offset];
+}
+
+void
+sStackAllocator::free_to_marker(sStackAllocatorMarker marker)
+{
+    S_MEMORY_ASSERT(marker.offset <= currentOffset && "Marker is above the top of the stack.");
+    S_MEMORY_ASSERT(marker.ID <= currentID);
+    if(marker.offset > currentOffset)
+        return;
+    currentOffset = marker.offset;
+    currentID = marker.ID;
+}
+
 //-----------------------------------------------------------------------------
-// [SECTION] Pool Allocator
+// [SECTION] Double-Ended Stack Allocator
 //-----------------------------------------------------------------------------
 
 static void
-_set_default_state(sPoolAllocator* allocator)
+_set_default_state(sDoubleStackAllocator* allocator)
 {
     S_MEMORY_ASSERT(allocator);
     allocator->autoCorrectAlignment = true;
-    allocator->type = S_POOL_ALLOCATOR;
+    allocator->type = S_DOUBLE_STACK_ALLOCATOR;
     allocator->parentType = S_ALLOCATOR_TYPE_NONE;
     allocator->parentAllocator = nullptr;
+    allocator->parent = {};
     allocator->buffer = nullptr;
     allocator->bufferSize = 0u;
-    allocator->chunkSize = 0u;
-    allocator->count = 0u;
-    allocator->freeItemCount = 0u;
-    allocator->head = nullptr;
+    allocator->lowerOffset = 0u;
+    allocator->upperOffset = 0u;
 }
 
 void
-sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, bool autoAlignment)
+sDoubleStackAllocator::initialize(size_t size, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(itemSize > 0u);
-    S_MEMORY_ASSERT(itemCount > 0u);
-    S_MEMORY_ASSERT(alignment > 0u);
-    autoCorrectAlignment = autoAlignment;
+    initialize(size, Semper::get_default_allocator(), autoAlignment);
     parentType = S_DEFAULT_ALLOCATOR;
-    count = itemCount;
-    freeItemCount = itemCount;
-    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
-    chunkSize = _align_forward_size(itemSize, alignment);
-    S_MEMORY_ASSERT(chunkSize >= sizeof(sPoolAllocatorNode) && "Chunk size too small.");
-    bufferSize = chunkSize * itemCount;
-    buffer = (unsigned char*)S_MEMORY_ALLOC(bufferSize);
-    head = (sPoolAllocatorNode*)buffer;
-
-    for(int i = 0; i < itemCount-1; i++)
-    {
-        ((sPoolAllocatorNode*)&buffer[chunkSize*i])->nextNode = (sPoolAllocatorNode*)&buffer[chunkSize*(i+1)];
-        ((sPoolAllocatorNode*)&(buffer[chunkSize*(i+1)]))->nextNode = nullptr;
-    }
 }
 
-void
-sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* allocator, bool autoAlignment)
+void 
+sDoubleStackAllocator::initialize(size_t size, void* allocator, bool autoAlignment)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(itemSize > 0u);
-    S_MEMORY_ASSERT(itemCount > 0u);
-    S_MEMORY_ASSERT(alignment > 0u);
     S_MEMORY_ASSERT(allocator != nullptr);
-
     if (allocator == nullptr)
-        return;
-    autoCorrectAlignment = autoAlignment;
-    parentType = *(sAllocatorType*)allocator;
-    parentAllocator = allocator;
-    count = itemCount;
-    freeItemCount = itemCount;
-    chunkSize = _align_forward_size(itemSize, alignment);
-    bufferSize = chunkSize*itemCount;
-    switch (parentType)
-    {
-    case S_LINEAR_ALLOCATOR:
-    {   
-        auto parentAllocator = (sLinearAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(bufferSize, bufferSize);
-        break;
-    }
-    case S_STACK_ALLOCATOR:
-    {
-        auto parentAllocator = (sStackAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(bufferSize, bufferSize);
-        break;
-    }
-    case S_POOL_ALLOCATOR:
-    {
-        auto parentAllocator = (sPoolAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_memory();
-        break;
-    }
-    case S_GENERAL_LL_ALLOCATOR:
     {
-        auto parentAllocator = (sGeneralLLAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(bufferSize, bufferSize);
-        break;
-    }
-    default:
-        S_MEMORY_ASSERT(false && "Parent allocator type not supported");
-        break;
+        _set_default_state(this);
+        return;
     }
 
-    head = (sPoolAllocatorNode*)buffer;
-
-    for(int i = 0; i < itemCount-1; i++)
-    {
-        ((sPoolAllocatorNode*)&buffer[chunkSize*i])->nextNode = (sPoolAllocatorNode*)&buffer[chunkSize*(i+1)];
-        ((sPoolAllocatorNode*)&(buffer[chunkSize*(i+1)]))->nextNode = nullptr;
-    }
+    initialize(size, _get_allocator_interface(allocator), autoAlignment);
+    parentType = *(sAllocatorType*)allocator;
+    parentAllocator = allocator;
 }
 
 void
-sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* memory, size_t size, bool autoAlignment)
+sDoubleStackAllocator::initialize(size_t size, sAllocator allocator, bool autoAlignment)
 {
     _set_default_state(this);
-    S_MEMORY_ASSERT(itemSize > 0u);
-    S_MEMORY_ASSERT(itemCount > 0u);
-    S_MEMORY_ASSERT(alignment > 0u);
+    S_PROFILE_REGISTER_(this);
     S_MEMORY_ASSERT(size > 0u);
-    S_MEMORY_ASSERT(memory);
-
-    if(memory == nullptr)
-        return;
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    bufferSize = size;
+    upperOffset = size;
+    buffer = (unsigned char*)_request_buffer(&parent, size, S_MEMORY_DEFAULT_ALIGNMENT);
+}
 
+void
+sDoubleStackAllocator::initialize(void* memory, size_t size, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(size > 0u);
+    S_MEMORY_ASSERT(memory != nullptr);
     autoCorrectAlignment = autoAlignment;
     parentType = S_EXTERNAL_ALLOCATOR;
-    count = itemCount;
-    freeItemCount = itemCount;
-    chunkSize = _align_forward_size(itemSize, alignment);
-
-    uintptr_t initial_start = (uintptr_t)memory;
-	uintptr_t start = _align_forward_uintptr(initial_start, (uintptr_t)alignment);
-    size-=(size_t)(start - initial_start);
     bufferSize = size;
-    
-    S_MEMORY_ASSERT(chunkSize >= sizeof(sPoolAllocatorNode) && "Chunk size too small.");
-    S_MEMORY_ASSERT(size >= chunkSize * itemCount && "Chunk size too small.");
-
+    upperOffset = size;
     buffer = (unsigned char*)memory;
-    head = (sPoolAllocatorNode*)buffer;
-
-    for(int i = 0; i < itemCount-1; i++)
-    {
-        ((sPoolAllocatorNode*)&buffer[chunkSize*i])->nextNode = (sPoolAllocatorNode*)&buffer[chunkSize*(i+1)];
-        ((sPoolAllocatorNode*)&(buffer[chunkSize*(i+1)]))->nextNode = nullptr;
-    }
 }
 
 void
-sPoolAllocator::free_memory()
+sDoubleStackAllocator::free_memory()
 {
+    S_PROFILE_UNREGISTER_(this);
     if (buffer)
-    {
-        switch (parentType)
-        {
-        case S_STACK_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sStackAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_POOL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sPoolAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        case S_DEFAULT_ALLOCATOR:
-        {
-            S_MEMORY_FREE(buffer);
-            break;
-        }
-        case S_GENERAL_LL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sGeneralLLAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
-            break;
-        }
-        default:
-            break;
-        }
-    }
+        _return_buffer(&parent, buffer);
     _set_default_state(this);
 }
 
-void*
-sPoolAllocator::request_memory()
+static void* _double_stack_request_memory(void* userData, size_t size, size_t alignment) { return ((sDoubleStackAllocator*)userData)->request_lower_aligned_memory(size, alignment);}
+static void  _double_stack_return_memory (void* userData, void* ptr)                     { (void)userData; (void)ptr;}
+
+sAllocator
+sDoubleStackAllocator::get_allocator()
 {
-    S_MEMORY_ASSERT(freeItemCount > 0u);
-    freeItemCount--;
-    sPoolAllocatorNode* firstFreeNode = head;
-    sPoolAllocatorNode* nextNode = firstFreeNode->nextNode;
-    head = nextNode;
-    return firstFreeNode;
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _double_stack_request_memory;
+    allocator.return_memory  = _double_stack_return_memory;
+    return allocator;
 }
 
-bool
-sPoolAllocator::return_memory(void* ptr)
+void*
+sDoubleStackAllocator::request_lower_memory(size_t size)
 {
-    freeItemCount++;
+    size_t offset = lowerOffset + size;
+
+    if (offset > upperOffset) // make sure we don't run into the upper stack
+    {
+        S_MEMORY_ASSERT(false && "Double stack allocator is full.");
+        return nullptr;
+    }
+
+    auto memory = (byte*)buffer + lowerOffset;
+    lowerOffset = offset;
+    S_PROFILE_REQUEST_(&stats, size, lowerOffset + bufferSize - upperOffset);
+    return memory;
+}
+
+void*
+sDoubleStackAllocator::request_lower_aligned_memory(size_t size, size_t alignment)
+{
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    S_MEMORY_ASSERT(_is_power_of_two(alignment));
+    uintptr_t curr_ptr = (uintptr_t)buffer + (uintptr_t)lowerOffset;
+    uintptr_t offset = _align_forward_uintptr(curr_ptr, alignment);
+    offset -= (uintptr_t)buffer;
+
+    if (offset+size > upperOffset)
+    {
+        S_MEMORY_ASSERT(false && "Double stack allocator is full.");
+        return nullptr;
+    }
+    lowerOffset = offset+size;
+    S_PROFILE_REQUEST_(&stats, size, lowerOffset + bufferSize - upperOffset);
+    return &buffer[offset];
+}
+
+void*
+sDoubleStackAllocator::request_upper_memory(size_t size)
+{
+    if (size > upperOffset - lowerOffset) // make sure we don't run into the lower stack
+    {
+        S_MEMORY_ASSERT(false && "Double stack allocator is full.");
+        return nullptr;
+    }
+
+    upperOffset -= size;
+    S_PROFILE_REQUEST_(&stats, size, lowerOffset + bufferSize - upperOffset);
+    return (byte*)buffer + upperOffset;
+}
+
+void*
+sDoubleStackAllocator::request_upper_aligned_memory(size_t size, size_t alignment)
+{
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    S_MEMORY_ASSERT(_is_power_of_two(alignment));
+    if (size > upperOffset - lowerOffset)
+    {
+        S_MEMORY_ASSERT(false && "Double stack allocator is full.");
+        return nullptr;
+    }
+
+    // align backward from the current top
+    uintptr_t start = (uintptr_t)buffer + (uintptr_t)(upperOffset - size);
+    start &= ~((uintptr_t)alignment - 1);
+    if (start < (uintptr_t)buffer + (uintptr_t)lowerOffset)
+    {
+        S_MEMORY_ASSERT(false && "Double stack allocator is full.");
+        return nullptr;
+    }
+    upperOffset = (size_t)(start - (uintptr_t)buffer);
+    S_PROFILE_REQUEST_(&stats, size, lowerOffset + bufferSize - upperOffset);
+    return &buffer[upperOffset];
+}
+
+void
+sDoubleStackAllocator::free_lower_to_marker(size_t marker)
+{
+    S_MEMORY_ASSERT(marker <= lowerOffset && "Marker is above the top of the lower stack.");
+    if(marker <= lowerOffset) lowerOffset = marker;
+}
+
+void
+sDoubleStackAllocator::free_upper_to_marker(size_t marker)
+{
+    S_MEMORY_ASSERT(marker >= upperOffset && marker <= bufferSize && "Marker is below the top of the upper stack.");
+    if(marker >= upperOffset && marker <= bufferSize) upperOffset = marker;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Frame Ring Allocator
+//-----------------------------------------------------------------------------
+
+static void
+_set_default_state(sFrameRingAllocator* allocator)
+{
+    S_MEMORY_ASSERT(allocator);
+    allocator->autoCorrectAlignment = true;
+    allocator->type = S_FRAME_RING_ALLOCATOR;
+    allocator->parentType = S_ALLOCATOR_TYPE_NONE;
+    allocator->parentAllocator = nullptr;
+    allocator->parent = {};
+    allocator->buffer = nullptr;
+    allocator->bufferSize = 0u;
+    allocator->head = 0u;
+    allocator->tail = 0u;
+    allocator->currentFrame = 0u;
+    allocator->oldestFrame = 0u;
+    allocator->framesInFlight = 1u;
+    memset(allocator->frameStarts, 0, sizeof(allocator->frameStarts));
+}
+
+void
+sFrameRingAllocator::initialize(size_t size, size_t frames, bool autoAlignment)
+{
+    initialize(size, frames, Semper::get_default_allocator(), autoAlignment);
+    parentType = S_DEFAULT_ALLOCATOR;
+}
+
+void
+sFrameRingAllocator::initialize(size_t size, size_t frames, void* allocator, bool autoAlignment)
+{
+    S_MEMORY_ASSERT(allocator != nullptr);
+    if (allocator == nullptr)
+    {
+        _set_default_state(this);
+        return;
+    }
+
+    initialize(size, frames, _get_allocator_interface(allocator), autoAlignment);
+    parentType = *(sAllocatorType*)allocator;
+    parentAllocator = allocator;
+}
+
+void
+sFrameRingAllocator::initialize(size_t size, size_t frames, sAllocator allocator, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
+    S_MEMORY_ASSERT(size > 0u);
+    S_MEMORY_ASSERT(frames > 0u && frames <= S_FRAME_RING_MAX_FRAMES);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    framesInFlight = frames;
+    bufferSize = size;
+    buffer = (unsigned char*)_request_buffer(&parent, size, S_MEMORY_DEFAULT_ALIGNMENT);
+}
+
+void
+sFrameRingAllocator::initialize(void* memory, size_t size, size_t frames, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(size > 0u);
+    S_MEMORY_ASSERT(memory != nullptr);
+    S_MEMORY_ASSERT(frames > 0u && frames <= S_FRAME_RING_MAX_FRAMES);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_EXTERNAL_ALLOCATOR;
+    framesInFlight = frames;
+    bufferSize = size;
+    buffer = (unsigned char*)memory;
+}
+
+void
+sFrameRingAllocator::free_memory()
+{
+    S_PROFILE_UNREGISTER_(this);
+    if (buffer)
+        _return_buffer(&parent, buffer);
+    _set_default_state(this);
+}
+
+static void* _frame_ring_request_memory(void* userData, size_t size, size_t alignment) { return ((sFrameRingAllocator*)userData)->request_aligned_memory(size, alignment);}
+static void  _frame_ring_return_memory (void* userData, void* ptr)                     { (void)userData; (void)ptr;}
+
+sAllocator
+sFrameRingAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _frame_ring_request_memory;
+    allocator.return_memory  = _frame_ring_return_memory;
+    return allocator;
+}
+
+void*
+sFrameRingAllocator::request_memory(size_t size)
+{
+    return request_aligned_memory(size, 1u);
+}
+
+void*
+sFrameRingAllocator::request_aligned_memory(size_t size, size_t alignment)
+{
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    S_MEMORY_ASSERT(_is_power_of_two(alignment));
+
+    size_t newHead = head;
+    size_t offset = newHead % bufferSize;
+    size_t padding = _align_forward_uintptr((uintptr_t)buffer + offset, alignment) - ((uintptr_t)buffer + offset);
+    if (offset + padding + size > bufferSize) // doesn't fit before the end, wrap to the start
+    {
+        newHead += bufferSize - offset;
+        offset = 0u;
+        padding = _align_forward_uintptr((uintptr_t)buffer, alignment) - (uintptr_t)buffer;
+    }
+    newHead += padding + size;
+
+    if (offset + padding + size > bufferSize || newHead - tail > bufferSize) // would overwrite a live frame
+    {
+        S_MEMORY_ASSERT(false && "Frame ring allocator doesn't have enough free memory.");
+        return nullptr;
+    }
+
+    head = newHead;
+    S_PROFILE_REQUEST_(&stats, size, head - tail);
+    return &buffer[offset + padding];
+}
+
+size_t
+sFrameRingAllocator::end_frame()
+{
+    size_t endedFrame = currentFrame;
+    if (currentFrame + 1u - oldestFrame >= framesInFlight)
+        retire_frame(currentFrame + 1u - framesInFlight);
+    currentFrame++;
+    frameStarts[currentFrame % S_FRAME_RING_MAX_FRAMES] = head;
+    return endedFrame;
+}
+
+void
+sFrameRingAllocator::retire_frame(size_t frame)
+{
+    S_MEMORY_ASSERT(frame <= currentFrame);
+    if (frame < oldestFrame) // already retired
+        return;
+    oldestFrame = frame + 1u;
+    tail = oldestFrame > currentFrame ? head : frameStarts[oldestFrame % S_FRAME_RING_MAX_FRAMES];
+}
+
+void
+sFrameRingAllocator::reset_allocator()
+{
+    head = 0u;
+    tail = 0u;
+    oldestFrame = currentFrame;
+    frameStarts[currentFrame % S_FRAME_RING_MAX_FRAMES] = 0u;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Pool Allocator
+//-----------------------------------------------------------------------------
+
+static void
+_set_default_state(sPoolAllocator* allocator)
+{
+    S_MEMORY_ASSERT(allocator);
+    allocator->autoCorrectAlignment = true;
+    allocator->type = S_POOL_ALLOCATOR;
+    allocator->parentType = S_ALLOCATOR_TYPE_NONE;
+    allocator->parentAllocator = nullptr;
+    allocator->parent = {};
+    allocator->buffer = nullptr;
+    allocator->bufferSize = 0u;
+    allocator->chunkSize = 0u;
+    allocator->count = 0u;
+    allocator->freeItemCount = 0u;
+    allocator->head = nullptr;
+}
+
+void
+sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, bool autoAlignment)
+{
+    initialize(itemCount, itemSize, alignment, Semper::get_default_allocator(), autoAlignment);
+    parentType = S_DEFAULT_ALLOCATOR;
+}
+
+void
+sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* allocator, bool autoAlignment)
+{
+    S_MEMORY_ASSERT(allocator != nullptr);
+    if (allocator == nullptr)
+    {
+        _set_default_state(this);
+        return;
+    }
+
+    initialize(itemCount, itemSize, alignment, _get_allocator_interface(allocator), autoAlignment);
+    parentType = *(sAllocatorType*)allocator;
+    parentAllocator = allocator;
+}
+
+void
+sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, sAllocator allocator, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
+    S_MEMORY_ASSERT(itemSize > 0u);
+    S_MEMORY_ASSERT(itemCount > 0u);
+    S_MEMORY_ASSERT(alignment > 0u);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    count = itemCount;
+    freeItemCount = itemCount;
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    chunkSize = _align_forward_size(itemSize, alignment);
+    S_MEMORY_ASSERT(chunkSize >= sizeof(sPoolAllocatorNode) && "Chunk size too small.");
+    bufferSize = chunkSize * itemCount;
+    buffer = (unsigned char*)_request_buffer(&parent, bufferSize, alignment);
+    head = (sPoolAllocatorNode*)buffer;
+
+    for(int i = 0; i < itemCount-1; i++)
+    {
+        ((sPoolAllocatorNode*)&buffer[chunkSize*i])->nextNode = (sPoolAllocatorNode*)&buffer[chunkSize*(i+1)];
+        ((sPoolAllocatorNode*)&(buffer[chunkSize*(i+1)]))->nextNode = nullptr;
+    }
+}
+
+void
+sPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* memory, size_t size, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(itemSize > 0u);
+    S_MEMORY_ASSERT(itemCount > 0u);
+    S_MEMORY_ASSERT(alignment > 0u);
+    S_MEMORY_ASSERT(size > 0u);
+    S_MEMORY_ASSERT(memory);
+
+    if(memory == nullptr)
+        return;
+
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_EXTERNAL_ALLOCATOR;
+    count = itemCount;
+    freeItemCount = itemCount;
+    chunkSize = _align_forward_size(itemSize, alignment);
+
+    uintptr_t initial_start = (uintptr_t)memory;
+	uintptr_t start = _align_forward_uintptr(initial_start, (uintptr_t)alignment);
+    size-=(size_t)(start - initial_start);
+    bufferSize = size;
+    
+    S_MEMORY_ASSERT(chunkSize >= sizeof(sPoolAllocatorNode) && "Chunk size too small.");
+    S_MEMORY_ASSERT(size >= chunkSize * itemCount && "Chunk size too small.");
+
+    buffer = (unsigned char*)memory;
+    head = (sPoolAllocatorNode*)buffer;
+
+    for(int i = 0; i < itemCount-1; i++)
+    {
+        ((sPoolAllocatorNode*)&buffer[chunkSize*i])->nextNode = (sPoolAllocatorNode*)&buffer[chunkSize*(i+1)];
+        ((sPoolAllocatorNode*)&(buffer[chunkSize*(i+1)]))->nextNode = nullptr;
+    }
+}
+
+void
+sPoolAllocator::free_memory()
+{
+    S_PROFILE_UNREGISTER_(this);
+    if (buffer)
+        _return_buffer(&parent, buffer);
+    _set_default_state(this);
+}
+
+static void*
+_pool_request_memory(void* userData, size_t size, size_t alignment)
+{
+    (void)alignment; // chunks are aligned when the pool is initialized
+    auto pool = (sPoolAllocator*)userData;
+    S_MEMORY_ASSERT(size <= pool->chunkSize && "Request doesn't fit in pool chunk.");
+    if(size > pool->chunkSize)
+        return nullptr;
+    return pool->request_memory();
+}
+
+static void _pool_return_memory(void* userData, void* ptr) { ((sPoolAllocator*)userData)->return_memory(ptr);}
+
+sAllocator
+sPoolAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _pool_request_memory;
+    allocator.return_memory  = _pool_return_memory;
+    return allocator;
+}
+
+void*
+sPoolAllocator::request_memory()
+{
+    S_MEMORY_ASSERT(freeItemCount > 0u);
+    freeItemCount--;
+    sPoolAllocatorNode* firstFreeNode = head;
+    sPoolAllocatorNode* nextNode = firstFreeNode->nextNode;
+    head = nextNode;
+    S_PROFILE_REQUEST_(&stats, chunkSize, (count - freeItemCount) * chunkSize);
+    return firstFreeNode;
+}
+
+bool
+sPoolAllocator::return_memory(void* ptr)
+{
+    freeItemCount++;
+    S_PROFILE_RETURN_(&stats);
     sPoolAllocatorNode* oldFreeNode = head;
     head = (sPoolAllocatorNode*)ptr;
     head->nextNode = oldFreeNode;
     return false;
 }
 
-//-----------------------------------------------------------------------------
-// [SECTION] General Allocator (Freelist using linked list)
-//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// [SECTION] Bitmap Pool Allocator
+//-----------------------------------------------------------------------------
+
+static void
+_set_default_state(sBitmapPoolAllocator* allocator)
+{
+    S_MEMORY_ASSERT(allocator);
+    allocator->autoCorrectAlignment = true;
+    allocator->type = S_BITMAP_POOL_ALLOCATOR;
+    allocator->parentType = S_ALLOCATOR_TYPE_NONE;
+    allocator->parentAllocator = nullptr;
+    allocator->parent = {};
+    allocator->buffer = nullptr;
+    allocator->bufferSize = 0u;
+    allocator->chunkSize = 0u;
+    allocator->count = 0u;
+    allocator->freeItemCount = 0u;
+    allocator->bitmap = nullptr;
+    allocator->wordCount = 0u;
+    allocator->firstFreeWord = 0u;
+}
+
+static size_t
+_bitmap_offset(size_t itemCount, size_t chunkSize)
+{
+    return _align_forward_size(itemCount * chunkSize, alignof(uint64_t));
+}
+
+size_t
+sBitmapPoolAllocator::get_required_size(size_t itemCount, size_t itemSize, size_t alignment)
+{
+    size_t chunk = _align_forward_size(itemSize, Semper::get_next_power_of_2(alignment));
+    return _bitmap_offset(itemCount, chunk) + ((itemCount + 63u) / 64u) * sizeof(uint64_t);
+}
+
+void
+sBitmapPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, bool autoAlignment)
+{
+    initialize(itemCount, itemSize, alignment, Semper::get_default_allocator(), autoAlignment);
+    parentType = S_DEFAULT_ALLOCATOR;
+}
+
+void
+sBitmapPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* allocator, bool autoAlignment)
+{
+    S_MEMORY_ASSERT(allocator != nullptr);
+    if (allocator == nullptr)
+    {
+        _set_default_state(this);
+        return;
+    }
+
+    initialize(itemCount, itemSize, alignment, _get_allocator_interface(allocator), autoAlignment);
+    parentType = *(sAllocatorType*)allocator;
+    parentAllocator = allocator;
+}
+
+void
+sBitmapPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, sAllocator allocator, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
+    S_MEMORY_ASSERT(itemSize > 0u);
+    S_MEMORY_ASSERT(itemCount > 0u);
+    S_MEMORY_ASSERT(alignment > 0u);
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    count = itemCount;
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    chunkSize = _align_forward_size(itemSize, alignment);
+    wordCount = (itemCount + 63u) / 64u;
+    bufferSize = _bitmap_offset(itemCount, chunkSize) + wordCount * sizeof(uint64_t);
+    buffer = (unsigned char*)_request_buffer(&parent, bufferSize, alignment);
+    if(buffer == nullptr)
+    {
+        _set_default_state(this);
+        return;
+    }
+    bitmap = (uint64_t*)&buffer[_bitmap_offset(itemCount, chunkSize)];
+    reset_allocator();
+}
+
+void
+sBitmapPoolAllocator::initialize(size_t itemCount, size_t itemSize, size_t alignment, void* memory, size_t size, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(itemSize > 0u);
+    S_MEMORY_ASSERT(itemCount > 0u);
+    S_MEMORY_ASSERT(alignment > 0u);
+    S_MEMORY_ASSERT(memory);
+
+    if(memory == nullptr)
+        return;
+
+    autoCorrectAlignment = autoAlignment;
+    parentType = S_EXTERNAL_ALLOCATOR;
+    count = itemCount;
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    chunkSize = _align_forward_size(itemSize, alignment);
+    wordCount = (itemCount + 63u) / 64u;
+
+    uintptr_t initial_start = (uintptr_t)memory;
+    uintptr_t start = _align_forward_uintptr(initial_start, (uintptr_t)alignment);
+    bufferSize = _bitmap_offset(itemCount, chunkSize) + wordCount * sizeof(uint64_t);
+    S_MEMORY_ASSERT(size >= bufferSize + (size_t)(start - initial_start) && "Memory too small for chunks & bitmap.");
+    if(size < bufferSize + (size_t)(start - initial_start))
+    {
+        _set_default_state(this);
+        return;
+    }
+
+    buffer = (unsigned char*)start;
+    bitmap = (uint64_t*)&buffer[_bitmap_offset(itemCount, chunkSize)];
+    reset_allocator();
+}
+
+void
+sBitmapPoolAllocator::free_memory()
+{
+    S_PROFILE_UNREGISTER_(this);
+    if (buffer)
+        _return_buffer(&parent, buffer);
+    _set_default_state(this);
+}
+
+static void*
+_bitmap_pool_request_memory(void* userData, size_t size, size_t alignment)
+{
+    (void)alignment; // chunks are aligned when the pool is initialized
+    auto pool = (sBitmapPoolAllocator*)userData;
+    S_MEMORY_ASSERT(size <= pool->chunkSize && "Request doesn't fit in pool chunk.");
+    if(size > pool->chunkSize)
+        return nullptr;
+    return pool->request_memory();
+}
+
+static void _bitmap_pool_return_memory(void* userData, void* ptr) { ((sBitmapPoolAllocator*)userData)->return_memory(ptr);}
+
+sAllocator
+sBitmapPoolAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _bitmap_pool_request_memory;
+    allocator.return_memory  = _bitmap_pool_return_memory;
+    return allocator;
+}
+
+void*
+sBitmapPoolAllocator::request_memory()
+{
+    for(size_t word = firstFreeWord; word < wordCount; word++)
+    {
+        uint64_t freeBits = ~bitmap[word];
+        if(freeBits == 0u)
+            continue;
+        size_t index = word * 64u + _count_trailing_zeros(freeBits);
+        bitmap[word] |= freeBits & (~freeBits + 1u); // set lowest free bit
+        firstFreeWord = word;
+        freeItemCount--;
+        S_PROFILE_REQUEST_(&stats, chunkSize, (count - freeItemCount) * chunkSize);
+        return &buffer[index * chunkSize];
+    }
+    firstFreeWord = wordCount;
+    S_MEMORY_ASSERT(false && "Bitmap pool allocator is full.");
+    return nullptr;
+}
+
+bool
+sBitmapPoolAllocator::return_memory(void* ptr)
+{
+    S_MEMORY_ASSERT(ptr >= buffer && ptr < &buffer[count * chunkSize] && "Pointer not owned by pool.");
+    size_t index = get_index(ptr);
+    S_MEMORY_ASSERT(get_chunk(index) == ptr && "Pointer not at start of chunk.");
+    uint64_t bit = (uint64_t)1u << (index % 64u);
+    size_t word = index / 64u;
+    if((bitmap[word] & bit) == 0u)
+    {
+        S_MEMORY_ASSERT(false && "Chunk returned twice.");
+        return false;
+    }
+    bitmap[word] &= ~bit;
+    if(word < firstFreeWord) firstFreeWord = word;
+    freeItemCount++;
+    S_PROFILE_RETURN_(&stats);
+    return true;
+}
+
+void
+sBitmapPoolAllocator::reset_allocator()
+{
+    memset(bitmap, 0, wordCount * sizeof(uint64_t));
+    if(count % 64u != 0u) // mark bits past count as live so they are never handed out
+        bitmap[wordCount - 1u] = ~(uint64_t)0u << (count % 64u);
+    freeItemCount = count;
+    firstFreeWord = 0u;
+}
+
+bool
+sBitmapPoolAllocator::is_live(void* ptr)
+{
+    size_t index = get_index(ptr);
+    if(ptr < buffer || index >= count)
+        return false;
+    return (bitmap[index / 64u] >> (index % 64u)) & 1u;
+}
+
+static void*
+_bitmap_pool_find_live(sBitmapPoolAllocator* allocator, size_t startIndex)
+{
+    if(startIndex >= allocator->count)
+        return nullptr;
+    size_t word = startIndex / 64u;
+    uint64_t bits = allocator->bitmap[word] & (~(uint64_t)0u << (startIndex % 64u));
+    while(true)
+    {
+        if(bits != 0u)
+        {
+            size_t index = word * 64u + _count_trailing_zeros(bits);
+            return index < allocator->count ? allocator->get_chunk(index) : nullptr; // skip padding bits
+        }
+        if(++word == allocator->wordCount)
+            return nullptr;
+        bits = allocator->bitmap[word];
+    }
+}
+
+void*
+sBitmapPoolAllocator::get_first_live()
+{
+    return _bitmap_pool_find_live(this, 0u);
+}
+
+void*
+sBitmapPoolAllocator::get_next_live(void* ptr)
+{
+    S_MEMORY_ASSERT(ptr);
+    return _bitmap_pool_find_live(this, get_index(ptr) + 1u);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] General Allocator (Freelist using linked list)
+//-----------------------------------------------------------------------------
+
+static void
+_set_default_state(sGeneralLLAllocator* allocator)
+{
+    S_MEMORY_ASSERT(allocator);
+    allocator->autoCorrectAlignment = true;
+    allocator->type = S_GENERAL_LL_ALLOCATOR;
+    allocator->parentType = S_ALLOCATOR_TYPE_NONE;
+    allocator->parentAllocator = nullptr;
+    allocator->parent = {};
+    allocator->buffer = nullptr;
+    allocator->bufferSize = 0u;
+    allocator->used = 0u;
+    allocator->head = nullptr;
+    allocator->placementPolicy = S_ALLOC_PLACEMENT_POLICY_NONE;
+}
+
+inline void
+_remove_node(sGeneralLLAllocatorNode **phead, sGeneralLLAllocatorNode *prev_node, sGeneralLLAllocatorNode *del_node) 
+{
+    if (prev_node == nullptr) *phead = del_node->nextNode; 
+    else prev_node->nextNode = del_node->nextNode; 
+}
+
+inline void
+_insert_node(sGeneralLLAllocatorNode **phead, sGeneralLLAllocatorNode *prev_node, sGeneralLLAllocatorNode *new_node) 
+{
+    if (prev_node == nullptr) 
+    {
+        new_node->nextNode = *phead;
+        *phead = new_node;
+    } 
+    else 
+    {
+        if (prev_node->nextNode == nullptr) 
+        {
+            prev_node->nextNode = new_node;
+            new_node->nextNode  = nullptr;
+        }
+         else
+          {
+            new_node->nextNode  = prev_node->nextNode;
+            prev_node->nextNode = new_node;
+        }
+    }
+}
+
+void
+sGeneralLLAllocator::initialize(size_t size, sAllocatorPlacementPolicy policy, bool autoAlignment)
+{
+    initialize(size, policy, Semper::get_default_allocator(), autoAlignment);
+    parentType = S_DEFAULT_ALLOCATOR;
+}
+
+void
+sGeneralLLAllocator::initialize(size_t size, sAllocatorPlacementPolicy policy, void* allocator, bool autoAlignment)
+{
+    S_MEMORY_ASSERT(allocator != nullptr);
+    if (allocator == nullptr)
+    {
+        _set_default_state(this);
+        return;
+    }
+
+    initialize(size, policy, _get_allocator_interface(allocator), autoAlignment);
+    parentType = *(sAllocatorType*)allocator;
+    parentAllocator = allocator;
+}
+
+void
+sGeneralLLAllocator::initialize(size_t size, sAllocatorPlacementPolicy policy, sAllocator allocator, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_REGISTER_(this);
+    S_MEMORY_ASSERT(size > 0);
+    autoCorrectAlignment = autoAlignment;
+    placementPolicy = policy;
+    parentType = S_CUSTOM_ALLOCATOR;
+    parentAllocator = allocator.userData;
+    parent = allocator;
+    bufferSize = size;
+    buffer = _request_buffer(&parent, size, S_MEMORY_DEFAULT_ALIGNMENT);
+    if(buffer == nullptr)
+    {
+        S_MEMORY_ASSERT(false && "Buffer could not be allocated.");
+       _set_default_state(this); 
+       return;
+    }
+    head = (sGeneralLLAllocatorNode*)buffer;
+    head->blockSize = size;
+    head->nextNode = nullptr;
+}
+
+void
+sGeneralLLAllocator::initialize(void* memory, sAllocatorPlacementPolicy policy, size_t size, bool autoAlignment)
+{
+    _set_default_state(this);
+    S_PROFILE_RESET_(this);
+    S_MEMORY_ASSERT(memory);
+    S_MEMORY_ASSERT(size > 0);
+    if(memory == nullptr)
+        return;
+    autoCorrectAlignment = autoAlignment;
+    buffer = memory;
+    placementPolicy = policy;
+    bufferSize = size;
+    parentType = S_EXTERNAL_ALLOCATOR;
+    head = (sGeneralLLAllocatorNode*)buffer;
+    head->blockSize = size;
+    head->nextNode = nullptr;
+}
+
+void sGeneralLLAllocator::free_memory()
+{
+    S_PROFILE_UNREGISTER_(this);
+    if (buffer)
+        _return_buffer(&parent, buffer);
+    _set_default_state(this);
+}
+
+static void* _general_ll_request_memory(void* userData, size_t size, size_t alignment) { return ((sGeneralLLAllocator*)userData)->request_aligned_memory(size, alignment);}
+static void  _general_ll_return_memory (void* userData, void* ptr)                     { ((sGeneralLLAllocator*)userData)->return_memory(ptr);}
+
+sAllocator
+sGeneralLLAllocator::get_allocator()
+{
+    sAllocator allocator{};
+    allocator.userData = this;
+    allocator.request_memory = _general_ll_request_memory;
+    allocator.return_memory  = _general_ll_return_memory;
+    return allocator;
+}
+
+void*
+sGeneralLLAllocator::request_memory(size_t size)
+{
+    return request_aligned_memory(size, size);
+}
+
+static sGeneralLLAllocatorNode*
+_request_aligned_memory_find_first(sGeneralLLAllocator* allocator, size_t size, size_t alignment, size_t *padding_, sGeneralLLAllocatorNode **prev_node_)
+{
+    sGeneralLLAllocatorNode* node = allocator->head;
+    sGeneralLLAllocatorNode* prevNode = nullptr;
+    size_t padding = 0;
+    while(node)
+    {
+        padding = _calc_padding_with_header((uintptr_t)node, alignment, sizeof(sGeneralLLAllocatorHeader));
+        size_t requiredSpace = size + padding;
+        if(node->blockSize >= requiredSpace)
+            break;
+        prevNode = node;
+        node = node->nextNode;
+    }
+    if (padding_) *padding_ = padding;
+    if (prev_node_) *prev_node_ = prevNode;
+    return node;
+}
+
+static sGeneralLLAllocatorNode*
+_request_aligned_memory_find_best(sGeneralLLAllocator* allocator, size_t size, size_t alignment, size_t *padding_, sGeneralLLAllocatorNode **prev_node_)
+{
+    size_t smallestDiff = ~(size_t)0;
+    sGeneralLLAllocatorNode* node = allocator->head;
+    sGeneralLLAllocatorNode* prevNode = nullptr;
+    sGeneralLLAllocatorNode* bestNode = nullptr;
+    size_t padding = 0;
+    while(node)
+    {
+        padding = _calc_padding_with_header((uintptr_t)node, (uintptr_t)alignment, sizeof(sGeneralLLAllocatorHeader));
+        size_t requiredSpace = size + padding;
+        if(node->blockSize >= requiredSpace && (node->blockSize - requiredSpace < smallestDiff))
+        {
+            bestNode = node;
+            smallestDiff = node->blockSize - requiredSpace;
+            if (padding_) *padding_ = padding;
+            if (prev_node_) *prev_node_ = prevNode;
+        }
+        prevNode = node;
+        node = node->nextNode;
+    }
+
+    return bestNode;
+}
+
+void*
+sGeneralLLAllocator::request_aligned_memory(size_t size, size_t alignment)
+{
+    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
+    S_MEMORY_ASSERT(size > 0u);
+
+    alignment = alignment < 8 ? 8 : alignment;
+    size = size < sizeof(sGeneralLLAllocatorNode) ? sizeof(sGeneralLLAllocatorNode) : size;
+
+    size_t padding = 0;  
+    sGeneralLLAllocatorNode *node = nullptr;
+    sGeneralLLAllocatorNode *prev_node = nullptr;
+    switch(placementPolicy)
+    {
+        case S_ALLOC_PLACEMENT_POLICY_FIND_BEST:  node = _request_aligned_memory_find_best(this, size, alignment, &padding, &prev_node); break;
+        case S_ALLOC_PLACEMENT_POLICY_FIND_FIRST: node = _request_aligned_memory_find_first(this, size, alignment, &padding, &prev_node); break;
+    }
+
+    if (node == nullptr) 
+    {
+        S_MEMORY_ASSERT(false && "Free list has no free memory");
+        return nullptr;
+    }
+    
+    size_t alignment_padding = padding - sizeof(sGeneralLLAllocatorHeader);
+    size_t required_space = _align_forward_size(size + padding, alignof(sGeneralLLAllocatorNode)); // keep next node aligned
+    if (required_space > node->blockSize) required_space = node->blockSize;
+    size_t remaining = node->blockSize - required_space;
+    if (remaining < sizeof(sGeneralLLAllocatorNode)) // too small to track, give it to this block
+    {
+        required_space += remaining;
+        remaining = 0;
+    }
+    used += required_space;
+    
+    if (remaining > 0) 
+    {
+        auto new_node = (sGeneralLLAllocatorNode*)((char *)node + required_space);
+        new_node->blockSize = remaining;
+        _insert_node(&head, node, new_node);
+    }
+    _remove_node(&head, prev_node, node);
+    
+    auto header_ptr = (sGeneralLLAllocatorHeader*)((char*)node + alignment_padding);
+    header_ptr->blockSize = required_space;
+    header_ptr->padding = alignment_padding;
+    S_PROFILE_REQUEST_(&stats, size, used);
+       
+    return ((char *)header_ptr + sizeof(sGeneralLLAllocatorHeader));
+}
+
+void
+sGeneralLLAllocator::return_memory(void* ptr)
+{
+    S_MEMORY_ASSERT(ptr);
+    if (ptr == nullptr) return;
+    
+    auto header = (sGeneralLLAllocatorHeader*)((char*)ptr - sizeof(sGeneralLLAllocatorHeader));
+    auto free_node = (sGeneralLLAllocatorNode*)((char*)header - header->padding); // block starts before alignment padding
+    free_node->blockSize = header->blockSize;
+    free_node->nextNode = nullptr;
+    
+    // free list is sorted by address
+    sGeneralLLAllocatorNode *node = head;
+    sGeneralLLAllocatorNode* prev_node = nullptr;
+    while (node != nullptr && node < free_node) 
+    {
+        prev_node = node;
+        node = node->nextNode;
+    }
+    _insert_node(&head, prev_node, free_node);
+    
+    used -= free_node->blockSize;
+    S_PROFILE_RETURN_(&stats);
+
+    // coalescence
+    if (free_node->nextNode != nullptr && (void *)((char *)free_node + free_node->blockSize) == free_node->nextNode) 
+    {
+        free_node->blockSize += free_node->nextNode->blockSize;
+        _remove_node(&head, free_node, free_node->nextNode);
+    }
+    
+    if (prev_node != nullptr && (void *)((char *)prev_node + prev_node->blockSize) == free_node) 
+    {
+        prev_node->blockSize += free_node->blockSize;
+        _remove_node(&head, prev_node, free_node);
+    }
+}
+
+float
+sGeneralLLAllocator::get_fragmentation()
+{
+    size_t totalFree = 0u;
+    size_t largestFree = 0u;
+    for(sGeneralLLAllocatorNode* node = head; node != nullptr; node = node->nextNode)
+    {
+        totalFree += node->blockSize;
+        if(node->blockSize > largestFree) largestFree = node->blockSize;
+    }
+    if(totalFree == 0u)
+        return 0.0f;
+    return 1.0f - (float)largestFree / (float)totalFree;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Profiling API
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_MEMORY_PROFILE)
+
+static const char*
+_profile_type_name(sAllocatorType type)
+{
+    switch(type)
+    {
+    case S_LINEAR_ALLOCATOR:       return "linear";
+    case S_STACK_ALLOCATOR:        return "stack";
+    case S_DOUBLE_STACK_ALLOCATOR: return "double_stack";
+    case S_FRAME_RING_ALLOCATOR:   return "frame_ring";
+    case S_POOL_ALLOCATOR:         return "pool";
+    case S_BITMAP_POOL_ALLOCATOR:  return "bitmap_pool";
+    case S_GENERAL_LL_ALLOCATOR:   return "general_ll";
+    case S_DEFAULT_ALLOCATOR:      return "default";
+    default:                       return "unknown";
+    }
+}
+
+struct sProfileEntry_
+{
+    const char*      typeName;
+    sAllocatorStats* stats;
+    void*            address;
+    size_t           bytesInUse;
+    size_t           bufferSize;
+    float            fragmentation;
+};
+
+static bool
+_profile_get_entry(void* allocator, sProfileEntry_* entry)
+{
+    sAllocatorType type = *(sAllocatorType*)allocator;
+    entry->typeName = _profile_type_name(type);
+    entry->address = allocator;
+    entry->fragmentation = 0.0f;
+    switch(type)
+    {
+    case S_LINEAR_ALLOCATOR:
+    {
+        auto a = (sLinearAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->currentOffset; entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_STACK_ALLOCATOR:
+    {
+        auto a = (sStackAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->currentOffset; entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_DOUBLE_STACK_ALLOCATOR:
+    {
+        auto a = (sDoubleStackAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->bufferSize - a->get_free_size(); entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_FRAME_RING_ALLOCATOR:
+    {
+        auto a = (sFrameRingAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->get_used_size(); entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_POOL_ALLOCATOR:
+    {
+        auto a = (sPoolAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = (a->count - a->freeItemCount) * a->chunkSize; entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_BITMAP_POOL_ALLOCATOR:
+    {
+        auto a = (sBitmapPoolAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->get_live_count() * a->chunkSize; entry->bufferSize = a->bufferSize;
+        return true;
+    }
+    case S_GENERAL_LL_ALLOCATOR:
+    {
+        auto a = (sGeneralLLAllocator*)allocator;
+        entry->stats = &a->stats; entry->bytesInUse = a->used; entry->bufferSize = a->bufferSize;
+        entry->fragmentation = a->get_fragmentation();
+        return true;
+    }
+    default: break;
+    }
+    return false;
+}
+
+void
+Semper::profile_callsite(const char* file, int line)
+{
+    g_semperProfilePendingFile = file;
+    g_semperProfilePendingLine = line;
+}
+
+void*
+Semper::profile_callsite_end(void* result)
+{
+    // a failed request never reaches _profile_request, don't let the callsite leak into the next one
+    g_semperProfilePendingFile = nullptr;
+    return result;
+}
+
+sAllocatorStats*
+Semper::get_default_allocator_stats()
+{
+    return &g_semperProfileDefaultStats;
+}
+
+void
+Semper::reset_memory_profile()
+{
+    memset(g_semperProfileCallsites, 0, sizeof(g_semperProfileCallsites));
+    const char* defaultName = g_semperProfileDefaultStats.name;
+    memset(&g_semperProfileDefaultStats, 0, sizeof(sAllocatorStats));
+    g_semperProfileDefaultStats.name = defaultName;
+    g_semperProfileDefaultStats.peakBytesInUse = g_semperProfileDefaultBytesInUse;
+    for(int i = 0; i < S_MEMORY_PROFILE_MAX_ALLOCATORS; i++)
+    {
+        sProfileEntry_ entry;
+        if(g_semperProfileAllocators[i] && _profile_get_entry(g_semperProfileAllocators[i], &entry))
+        {
+            const char* name = entry.stats->name;
+            memset(entry.stats, 0, sizeof(sAllocatorStats));
+            entry.stats->name = name;
+            entry.stats->peakBytesInUse = entry.bytesInUse;
+        }
+    }
+    g_semperProfilePendingFile = nullptr;
+}
+
+// names & paths are user provided (quotes, windows paths)
+static void
+_profile_write_json_string(FILE* file, const char* string)
+{
+    fputc('"', file);
+    for(const char* c = string; *c; c++)
+    {
+        if(*c == '"' || *c == '\\')
+            fputc('\\', file);
+        if((unsigned char)*c < 0x20)
+            fprintf(file, "\\u%04x", (unsigned int)(unsigned char)*c);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+static void
+_profile_write_csv_string(FILE* file, const char* string)
+{
+    fputc('"', file);
+    for(const char* c = string; *c; c++)
+    {
+        if(*c == '"')
+            fputc('"', file);
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+static void
+_profile_write_json_entry(FILE* file, sProfileEntry_* entry, bool first)
+{
+    sAllocatorStats* stats = entry->stats;
+    fprintf(file, "%s\n    {\"name\": ", first ? "" : ",");
+    _profile_write_json_string(file, stats->name ? stats->name : "");
+    fprintf(file, ", \"type\": \"%s\", \"address\": \"%p\", ", entry->typeName, entry->address);
+    fprintf(file, "\"requests\": %zu, \"returns\": %zu, \"bytesRequested\": %zu, ", stats->requestCount, stats->returnCount, stats->bytesRequested);
+    fprintf(file, "\"bytesInUse\": %zu, \"peakBytesInUse\": %zu, \"bufferSize\": %zu, \"fragmentation\": %f, \"histogram\": [", entry->bytesInUse, stats->peakBytesInUse, entry->bufferSize, entry->fragmentation);
+    for(int i = 0; i < S_MEMORY_PROFILE_HISTOGRAM_BUCKETS; i++)
+        fprintf(file, i == 0 ? "%zu" : ", %zu", stats->histogram[i]);
+    fprintf(file, "]}");
+}
+
+static void
+_profile_write_csv_entry(FILE* file, sProfileEntry_* entry)
+{
+    sAllocatorStats* stats = entry->stats;
+    fprintf(file, "allocator,");
+    _profile_write_csv_string(file, stats->name ? stats->name : "");
+    fprintf(file, ",%s,%p,%zu,%zu,%zu,%zu,%zu,%zu,%f", entry->typeName, entry->address,
+        stats->requestCount, stats->returnCount, stats->bytesRequested, entry->bytesInUse, stats->peakBytesInUse, entry->bufferSize, entry->fragmentation);
+    for(int i = 0; i < S_MEMORY_PROFILE_HISTOGRAM_BUCKETS; i++)
+        fprintf(file, ",%zu", stats->histogram[i]);
+    fprintf(file, "\n");
+}
+
+bool
+Semper::dump_memory_profile(const char* fileName, sMemoryProfileFormat format)
+{
+    FILE* file = fopen(fileName, "w");
+    if(file == nullptr)
+    {
+        S_MEMORY_ASSERT(false && "Could not open profile file.");
+        return false;
+    }
+
+    sProfileEntry_ defaultEntry = {};
+    defaultEntry.typeName = _profile_type_name(S_DEFAULT_ALLOCATOR);
+    defaultEntry.stats = &g_semperProfileDefaultStats;
+    defaultEntry.bytesInUse = g_semperProfileDefaultBytesInUse;
+
+    if(format == S_MEMORY_PROFILE_FORMAT_JSON)
+    {
+        fprintf(file, "{\n  \"allocators\": [");
+        _profile_write_json_entry(file, &defaultEntry, true);
+        for(int i = 0; i < S_MEMORY_PROFILE_MAX_ALLOCATORS; i++)
+        {
+            sProfileEntry_ entry;
+            if(g_semperProfileAllocators[i] && _profile_get_entry(g_semperProfileAllocators[i], &entry))
+                _profile_write_json_entry(file, &entry, false);
+        }
+        fprintf(file, "\n  ],\n  \"callsites\": [");
+        bool first = true;
+        for(int i = 0; i < S_MEMORY_PROFILE_MAX_CALLSITES; i++)
+        {
+            sAllocationCallsite& callsite = g_semperProfileCallsites[i];
+            if(callsite.file == nullptr)
+                continue;
+            fprintf(file, "%s\n    {\"file\": ", first ? "" : ",");
+            _profile_write_json_string(file, callsite.file);
+            fprintf(file, ", \"line\": %d, \"requests\": %zu, \"bytesRequested\": %zu}", callsite.line, callsite.requestCount, callsite.bytesRequested);
+            first = false;
+        }
+        fprintf(file, "\n  ]\n}\n");
+    }
+    else
+    {
+        // allocator rows: record,name,type,address,requests,returns,bytes_requested,bytes_in_use,peak_bytes_in_use,buffer_size,fragmentation,h0..hN
+        // callsite rows:  record,file,line,requests,bytes_requested
+        fprintf(file, "record,name,type,address,requests,returns,bytes_requested,bytes_in_use,peak_bytes_in_use,buffer_size,fragmentation");
+        for(int i = 0; i < S_MEMORY_PROFILE_HISTOGRAM_BUCKETS; i++)
+            fprintf(file, ",h%d", i);
+        fprintf(file, "\n");
+        _profile_write_csv_entry(file, &defaultEntry);
+        for(int i = 0; i < S_MEMORY_PROFILE_MAX_ALLOCATORS; i++)
+        {
+            sProfileEntry_ entry;
+            if(g_semperProfileAllocators[i] && _profile_get_entry(g_semperProfileAllocators[i], &entry))
+                _profile_write_csv_entry(file, &entry);
+        }
+        for(int i = 0; i < S_MEMORY_PROFILE_MAX_CALLSITES; i++)
+        {
+            sAllocationCallsite& callsite = g_semperProfileCallsites[i];
+            if(callsite.file == nullptr)
+                continue;
+            fprintf(file, "callsite,");
+            _profile_write_csv_string(file, callsite.file);
+            fprintf(file, ",%d,%zu,%zu\n", callsite.line, callsite.requestCount, callsite.bytesRequested);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+#else
+
+void             Semper::profile_callsite(const char* file, int line) { (void)file; (void)line;}
+void*            Semper::profile_callsite_end(void* result) { return result;}
+void             Semper::reset_memory_profile() {}
+bool             Semper::dump_memory_profile(const char* file, sMemoryProfileFormat format) { (void)file; (void)format; return false;}
+sAllocatorStats* Semper::get_default_allocator_stats() { return nullptr;}
+
+#endif // SEMPER_MEMORY_PROFILE
+
+//-----------------------------------------------------------------------------
+// [SECTION] Benchmark
+//-----------------------------------------------------------------------------
+
+#if defined(SEMPER_MEMORY_BENCHMARK)
+
+#include <stdio.h> // printf
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+enum sBenchOpType_
+{
+    S_BENCH_OP_REQUEST_,
+    S_BENCH_OP_RETURN_,
+    S_BENCH_OP_CLEANUP_,  // end of frame return (skipped by allocators that reset)
+    S_BENCH_OP_END_FRAME_
+};
+
+struct sBenchOp_
+{
+    int          type; // sBenchOpType_
+    unsigned int slot;
+    unsigned int size;
+};
+
+struct sBenchTrace_
+{
+    const char* name;
+    sBenchOp_*  ops;
+    size_t      opCount;
+    size_t      slotCount;
+    size_t      maxSize;        // largest request (bytes)
+    size_t      maxLiveCount;   // most allocations alive at once
+    size_t      arenaSize;      // buffer large enough for the trace (bytes)
+    bool        needsReturnAny; // returns out of order
+    bool        threaded;       // producer/consumer (requests on one thread, returns on another)
+};
+
+struct sBenchSubject_
+{
+    const char*               name;
+    bool                      canReturnAny;
+    bool                      canReset;
+    bool                      threadSafe;
+    sAllocatorPlacementPolicy policy;
+    sLinearAllocator          linear;
+    sStackAllocator           stack;
+    sPoolAllocator            pool;
+    sGeneralLLAllocator       general;
+    sFrameRingAllocator       frameRing;
+    sBitmapPoolAllocator      bitmapPool;
+    void   (*create)       (sBenchSubject_* subject, sBenchTrace_* trace);
+    void   (*destroy)      (sBenchSubject_* subject);
+    void*  (*request)      (sBenchSubject_* subject, size_t size);
+    void   (*release)      (sBenchSubject_* subject, void* ptr);
+    void   (*reset)        (sBenchSubject_* subject);
+    float  (*fragmentation)(sBenchSubject_* subject);
+};
+
+static unsigned int
+_bench_random(unsigned int* state) // xorshift32
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
 
-static void
-_set_default_state(sGeneralLLAllocator* allocator)
+static unsigned int
+_bench_random_size(unsigned int* state, unsigned int minSize, unsigned int maxSize) // log-uniform, small requests dominate
 {
-    S_MEMORY_ASSERT(allocator);
-    allocator->autoCorrectAlignment = true;
-    allocator->type = S_GENERAL_LL_ALLOCATOR;
-    allocator->parentType = S_ALLOCATOR_TYPE_NONE;
-    allocator->parentAllocator = nullptr;
-    allocator->buffer = nullptr;
-    allocator->bufferSize = 0u;
-    allocator->used = 0u;
-    allocator->head = nullptr;
-    allocator->placementPolicy = S_ALLOC_PLACEMENT_POLICY_NONE;
+    unsigned int minBit = 0u; while((2u << minBit) <= minSize) minBit++;
+    unsigned int maxBit = 0u; while((2u << maxBit) <= maxSize) maxBit++;
+    unsigned int bit = minBit + _bench_random(state) % (maxBit - minBit + 1u);
+    unsigned int size = (1u << bit) + _bench_random(state) % (1u << bit);
+    return size < minSize ? minSize : (size > maxSize ? maxSize : size);
 }
 
-inline void
-_remove_node(sGeneralLLAllocatorNode **phead, sGeneralLLAllocatorNode *prev_node, sGeneralLLAllocatorNode *del_node) 
+static void
+_bench_push_op(sBenchTrace_* trace, size_t capacity, int type, unsigned int slot, unsigned int size)
 {
-    if (prev_node == nullptr) *phead = del_node->nextNode; 
-    else prev_node->nextNode = del_node->nextNode; 
+    S_MEMORY_ASSERT(trace->opCount < capacity);
+    if(trace->opCount >= capacity)
+        return;
+    trace->ops[trace->opCount++] = {type, slot, size};
 }
 
-inline void
-_insert_node(sGeneralLLAllocatorNode **phead, sGeneralLLAllocatorNode *prev_node, sGeneralLLAllocatorNode *new_node) 
+// each frame requests a burst of transient data, everything is released at the end of the frame
+static void
+_bench_generate_frame_churn(sBenchTrace_* trace, size_t operations, unsigned int seed)
 {
-    if (prev_node == nullptr) 
-    {
-        if (*phead != nullptr) new_node->nextNode = *phead; 
-        else *phead = new_node;
-    } 
-    else 
+    const size_t capacity = operations + 1024u;
+    *trace = {};
+    trace->name = "frame_churn";
+    trace->ops = (sBenchOp_*)malloc(capacity * sizeof(sBenchOp_));
+    trace->slotCount = 512u;
+    trace->maxSize = 1024u;
+    while(trace->opCount + 2u * trace->slotCount + 1u < operations)
     {
-        if (prev_node->nextNode == nullptr) 
+        unsigned int count = 64u + _bench_random(&seed) % 449u;
+        size_t frameBytes = 0u;
+        for(unsigned int i = 0u; i < count; i++)
         {
-            prev_node->nextNode = new_node;
-            new_node->nextNode  = nullptr;
-        }
-         else
-          {
-            new_node->nextNode  = prev_node->nextNode;
-            prev_node->nextNode = new_node;
+            unsigned int size = _bench_random_size(&seed, 16u, 1024u);
+            frameBytes += size + 64u; // headers & padding
+            _bench_push_op(trace, capacity, S_BENCH_OP_REQUEST_, i, size);
         }
+        for(unsigned int i = count; i > 0u; i--)
+            _bench_push_op(trace, capacity, S_BENCH_OP_CLEANUP_, i - 1u, 0u);
+        _bench_push_op(trace, capacity, S_BENCH_OP_END_FRAME_, 0u, 0u);
+        if(count > trace->maxLiveCount) trace->maxLiveCount = count;
+        if(frameBytes > trace->arenaSize) trace->arenaSize = frameBytes;
     }
 }
 
-void
-sGeneralLLAllocator::initialize(size_t size, sAllocatorPlacementPolicy policy, bool autoAlignment)
+// many small nodes per document, scratch buffers returned immediately (LIFO)
+static void
+_bench_generate_parser_burst(sBenchTrace_* trace, size_t operations, unsigned int seed)
 {
-    _set_default_state(this);
-    autoCorrectAlignment = autoAlignment;
-    buffer = S_MEMORY_ALLOC(size);
-    placementPolicy = policy;
-    bufferSize = size;
-    parentType = S_DEFAULT_ALLOCATOR;
-    head = (sGeneralLLAllocatorNode*)buffer;
-    head->blockSize = size;
-    head->nextNode = nullptr;
+    const size_t capacity = operations + 16384u;
+    *trace = {};
+    trace->name = "parser_burst";
+    trace->ops = (sBenchOp_*)malloc(capacity * sizeof(sBenchOp_));
+    trace->slotCount = 4096u;
+    trace->maxSize = 4096u;
+    while(trace->opCount + 3u * trace->slotCount + 1u < operations)
+    {
+        unsigned int count = 1024u + _bench_random(&seed) % 3072u;
+        unsigned int live = 0u;
+        size_t burstBytes = 0u;
+        while(live < count)
+        {
+            if(_bench_random(&seed) % 8u == 0u) // scratch buffer
+            {
+                unsigned int size = _bench_random_size(&seed, 256u, 4096u);
+                burstBytes += size + 64u;
+                _bench_push_op(trace, capacity, S_BENCH_OP_REQUEST_, live, size);
+                _bench_push_op(trace, capacity, S_BENCH_OP_RETURN_, live, 0u);
+            }
+            unsigned int size = _bench_random_size(&seed, 8u, 128u);
+            burstBytes += size + 64u;
+            _bench_push_op(trace, capacity, S_BENCH_OP_REQUEST_, live++, size);
+        }
+        for(unsigned int i = count; i > 0u; i--)
+            _bench_push_op(trace, capacity, S_BENCH_OP_CLEANUP_, i - 1u, 0u);
+        _bench_push_op(trace, capacity, S_BENCH_OP_END_FRAME_, 0u, 0u);
+        if(count + 1u > trace->maxLiveCount) trace->maxLiveCount = count + 1u;
+        if(burstBytes > trace->arenaSize) trace->arenaSize = burstBytes;
+    }
 }
 
-void
-sGeneralLLAllocator::initialize(size_t size, sAllocatorPlacementPolicy policy, void* allocator, bool autoAlignment)
+// long-lived resources replaced rarely, interleaved with short-lived churn
+static void
+_bench_generate_long_short_mix(sBenchTrace_* trace, size_t operations, unsigned int seed)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(allocator != nullptr);
-    S_MEMORY_ASSERT(size > 0);
-    
-    if (allocator == nullptr)
-        return;
- 
-    parentType = *(sAllocatorType*)allocator;
-    switch (parentType)
-    {
-    case S_LINEAR_ALLOCATOR:
-    {   
-        auto parentAllocator = (sLinearAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_STACK_ALLOCATOR:
-    {
-        auto parentAllocator = (sStackAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    case S_POOL_ALLOCATOR:
-    {
-        auto parentAllocator = (sPoolAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_memory();
-        break;
-    }
-    case S_GENERAL_LL_ALLOCATOR:
-    {
-        auto parentAllocator = (sGeneralLLAllocator*)allocator;
-        buffer = (unsigned char*)parentAllocator->request_aligned_memory(size, size);
-        break;
-    }
-    default:
-        S_MEMORY_ASSERT(false && "Parent allocator type not supported");
-        break;
-    }
-    
-    autoCorrectAlignment = autoAlignment;
-    placementPolicy = policy;
-    parentAllocator = allocator;
-    bufferSize = size;
-    head = (sGeneralLLAllocatorNode*)buffer;
-    head->blockSize = size;
-    head->nextNode = nullptr;
-    if(buffer == nullptr)
+    const unsigned int longSlots = 512u;
+    const unsigned int shortSlots = 512u;
+    *trace = {};
+    trace->name = "long_short_mix";
+    trace->ops = (sBenchOp_*)malloc(operations * sizeof(sBenchOp_));
+    trace->slotCount = longSlots + shortSlots;
+    trace->maxSize = 4096u;
+    trace->maxLiveCount = trace->slotCount;
+    trace->arenaSize = 4u * (longSlots * (4096u + 64u) + shortSlots * (512u + 64u)); // headroom for fragmentation
+    trace->needsReturnAny = true;
+    bool* occupied = (bool*)calloc(trace->slotCount, sizeof(bool));
+    while(trace->opCount < operations)
     {
-        S_MEMORY_ASSERT(false && "Buffer could not be allocated.");
-       _set_default_state(this); 
+        bool longLived = _bench_random(&seed) % 100u < 2u;
+        unsigned int slot = longLived ? _bench_random(&seed) % longSlots : longSlots + _bench_random(&seed) % shortSlots;
+        if(occupied[slot])
+            _bench_push_op(trace, operations, S_BENCH_OP_RETURN_, slot, 0u);
+        else
+            _bench_push_op(trace, operations, S_BENCH_OP_REQUEST_, slot, longLived ? _bench_random_size(&seed, 64u, 4096u) : _bench_random_size(&seed, 16u, 512u));
+        occupied[slot] = !occupied[slot];
     }
+    free(occupied);
 }
 
-void
-sGeneralLLAllocator::initialize(void* memory, sAllocatorPlacementPolicy policy, size_t size, bool autoAlignment)
+// requests on a producer thread, returns on a consumer thread
+static void
+_bench_generate_producer_consumer(sBenchTrace_* trace, size_t operations, unsigned int seed)
 {
-    _set_default_state(this);
-    S_MEMORY_ASSERT(memory);
-    S_MEMORY_ASSERT(size > 0);
-    if(memory == nullptr)
-        return;
-    autoCorrectAlignment = autoAlignment;
-    buffer = memory;
-    placementPolicy = policy;
-    bufferSize = size;
-    parentType = S_EXTERNAL_ALLOCATOR;
-    head = (sGeneralLLAllocatorNode*)buffer;
-    head->blockSize = size;
-    head->nextNode = nullptr;
+    *trace = {};
+    trace->name = "producer_consumer";
+    trace->opCount = operations / 2u;
+    trace->ops = (sBenchOp_*)malloc(trace->opCount * sizeof(sBenchOp_));
+    trace->slotCount = 1024u; // in flight
+    trace->maxSize = 1024u;
+    trace->maxLiveCount = trace->slotCount + 1u;
+    trace->arenaSize = 4u * trace->maxLiveCount * (1024u + 64u);
+    trace->needsReturnAny = true;
+    trace->threaded = true;
+    for(size_t i = 0u; i < trace->opCount; i++)
+        trace->ops[i] = {S_BENCH_OP_REQUEST_, (unsigned int)(i % trace->slotCount), _bench_random_size(&seed, 16u, 1024u)};
 }
 
-void sGeneralLLAllocator::free_memory()
+static void   _bench_malloc_create (sBenchSubject_* subject, sBenchTrace_* trace) { (void)subject; (void)trace;}
+static void   _bench_malloc_destroy(sBenchSubject_* subject) { (void)subject;}
+static void*  _bench_malloc_request(sBenchSubject_* subject, size_t size) { (void)subject; return malloc(size);}
+static void   _bench_malloc_release(sBenchSubject_* subject, void* ptr) { (void)subject; free(ptr);}
+
+static void   _bench_linear_create (sBenchSubject_* subject, sBenchTrace_* trace) { subject->linear.initialize(trace->arenaSize);}
+static void   _bench_linear_destroy(sBenchSubject_* subject) { subject->linear.free_memory();}
+static void*  _bench_linear_request(sBenchSubject_* subject, size_t size) { return subject->linear.request_aligned_memory(size, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_linear_release(sBenchSubject_* subject, void* ptr) { (void)subject; (void)ptr;}
+static void   _bench_linear_reset  (sBenchSubject_* subject) { subject->linear.reset_allocator();}
+
+static void   _bench_stack_create (sBenchSubject_* subject, sBenchTrace_* trace) { subject->stack.initialize(trace->arenaSize);}
+static void   _bench_stack_destroy(sBenchSubject_* subject) { subject->stack.free_memory();}
+static void*  _bench_stack_request(sBenchSubject_* subject, size_t size) { return subject->stack.request_aligned_memory(size, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_stack_release(sBenchSubject_* subject, void* ptr) { subject->stack.return_memory(ptr);}
+static void   _bench_stack_reset  (sBenchSubject_* subject) { subject->stack.reset_allocator();}
+
+static void   _bench_frame_ring_create (sBenchSubject_* subject, sBenchTrace_* trace) { subject->frameRing.initialize(trace->arenaSize, 1u);}
+static void   _bench_frame_ring_destroy(sBenchSubject_* subject) { subject->frameRing.free_memory();}
+static void*  _bench_frame_ring_request(sBenchSubject_* subject, size_t size) { return subject->frameRing.request_aligned_memory(size, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_frame_ring_reset  (sBenchSubject_* subject) { subject->frameRing.end_frame();}
+
+static void   _bench_pool_create (sBenchSubject_* subject, sBenchTrace_* trace) { subject->pool.initialize(trace->maxLiveCount, trace->maxSize, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_pool_destroy(sBenchSubject_* subject) { subject->pool.free_memory();}
+static void*  _bench_pool_request(sBenchSubject_* subject, size_t size) { (void)size; return subject->pool.request_memory();}
+static void   _bench_pool_release(sBenchSubject_* subject, void* ptr) { subject->pool.return_memory(ptr);}
+
+static void   _bench_bitmap_pool_create (sBenchSubject_* subject, sBenchTrace_* trace) { subject->bitmapPool.initialize(trace->maxLiveCount, trace->maxSize, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_bitmap_pool_destroy(sBenchSubject_* subject) { subject->bitmapPool.free_memory();}
+static void*  _bench_bitmap_pool_request(sBenchSubject_* subject, size_t size) { (void)size; return subject->bitmapPool.request_memory();}
+static void   _bench_bitmap_pool_release(sBenchSubject_* subject, void* ptr) { subject->bitmapPool.return_memory(ptr);}
+
+static void   _bench_general_create       (sBenchSubject_* subject, sBenchTrace_* trace) { subject->general.initialize(trace->arenaSize, subject->policy);}
+static void   _bench_general_destroy      (sBenchSubject_* subject) { subject->general.free_memory();}
+static void*  _bench_general_request      (sBenchSubject_* subject, size_t size) { return subject->general.request_aligned_memory(size, S_MEMORY_DEFAULT_ALIGNMENT);}
+static void   _bench_general_release      (sBenchSubject_* subject, void* ptr) { subject->general.return_memory(ptr);}
+static float  _bench_general_fragmentation(sBenchSubject_* subject) { return subject->general.get_fragmentation();}
+
+static void
+_bench_subject(sBenchSubject_* subject, const char* name, bool canReturnAny, bool canReset, bool threadSafe, sAllocatorPlacementPolicy policy=S_ALLOC_PLACEMENT_POLICY_FIND_FIRST)
 {
-    if (buffer)
+    *subject = sBenchSubject_{}; // the caller sets the callbacks
+    subject->name = name;
+    subject->canReturnAny = canReturnAny;
+    subject->canReset = canReset;
+    subject->threadSafe = threadSafe;
+    subject->policy = policy;
+}
+
+static unsigned int
+_bench_elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return (unsigned int)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static size_t
+_bench_replay(sBenchSubject_* subject, sBenchTrace_* trace, void** slots, unsigned int* latencies, size_t* failures)
+{
+    size_t timedCount = 0u;
+    for(size_t i = 0u; i < trace->opCount; i++)
     {
-        switch (parentType)
-        {
-        case S_STACK_ALLOCATOR:
+        const sBenchOp_& op = trace->ops[i];
+        if(op.type == S_BENCH_OP_CLEANUP_ && subject->canReset)
+            continue;
+        if(op.type == S_BENCH_OP_END_FRAME_ && !subject->canReset)
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+        switch(op.type)
         {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sStackAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
+        case S_BENCH_OP_REQUEST_:
+            slots[op.slot] = subject->request(subject, op.size);
             break;
-        }
-        case S_POOL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sPoolAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
+        case S_BENCH_OP_RETURN_:
+        case S_BENCH_OP_CLEANUP_:
+            if(slots[op.slot]) subject->release(subject, slots[op.slot]);
             break;
-        }
-        case S_GENERAL_LL_ALLOCATOR:
-        {
-            S_MEMORY_ASSERT(parentAllocator);
-            auto parentAllocator = (sGeneralLLAllocator*)this->parentAllocator;
-            parentAllocator->return_memory(buffer);
+        case S_BENCH_OP_END_FRAME_:
+            subject->reset(subject);
             break;
         }
-        case S_DEFAULT_ALLOCATOR:
+        latencies[timedCount++] = _bench_elapsed_ns(start);
+
+        if(op.type == S_BENCH_OP_REQUEST_)
         {
-            S_MEMORY_FREE(buffer);
-            break;
-        }
-        default:
-            break;
+            if(slots[op.slot]) *(unsigned char*)slots[op.slot] = 1u; // touch
+            else (*failures)++;
         }
+        else
+            slots[op.slot] = nullptr;
     }
-    _set_default_state(this);
+    return timedCount;
 }
 
-void*
-sGeneralLLAllocator::request_memory(size_t size)
+static size_t
+_bench_replay_threaded(sBenchSubject_* subject, sBenchTrace_* trace, unsigned int* latencies, size_t* failures)
 {
-    return request_aligned_memory(size, size);
-}
+    std::mutex allocatorMutex; // Semper allocators are not thread-safe
+    std::atomic<size_t> produced(0u);
+    std::atomic<size_t> consumed(0u);
+    void** ring = (void**)malloc(trace->slotCount * sizeof(void*));
+    size_t producerFailures = 0u;
 
-static sGeneralLLAllocatorNode*
-_request_aligned_memory_find_first(sGeneralLLAllocator* allocator, size_t size, size_t alignment, size_t *padding_, sGeneralLLAllocatorNode **prev_node_)
-{
-    sGeneralLLAllocatorNode* node = allocator->head;
-    sGeneralLLAllocatorNode* prevNode = nullptr;
-    size_t padding = 0;
-    while(node)
+    std::thread consumer([&]()
     {
-        padding = _calc_padding_with_header((uintptr_t)node, alignment, sizeof(sGeneralLLAllocatorHeader));
-        size_t requiredSpace = size + padding;
-        if(node->blockSize >= requiredSpace)
-            break;
-        prevNode = node;
-        node = node->nextNode;
-    }
-    if (padding_) *padding_ = padding;
-    if (prev_node_) *prev_node_ = prevNode;
-    return node;
-}
+        for(size_t i = 0u; i < trace->opCount; i++)
+        {
+            while(produced.load(std::memory_order_acquire) <= i)
+                std::this_thread::yield();
+            void* ptr = ring[i % trace->slotCount];
+            auto start = std::chrono::steady_clock::now();
+            if(ptr)
+            {
+                if(subject->threadSafe)
+                    subject->release(subject, ptr);
+                else
+                {
+                    std::lock_guard<std::mutex> lock(allocatorMutex);
+                    subject->release(subject, ptr);
+                }
+            }
+            latencies[trace->opCount + i] = _bench_elapsed_ns(start);
+            consumed.store(i + 1u, std::memory_order_release);
+        }
+    });
 
-static sGeneralLLAllocatorNode*
-_request_aligned_memory_find_best(sGeneralLLAllocator* allocator, size_t size, size_t alignment, size_t *padding_, sGeneralLLAllocatorNode **prev_node_)
-{
-    size_t smallestDiff = ~(size_t)0;
-    sGeneralLLAllocatorNode* node = allocator->head;
-    sGeneralLLAllocatorNode* prevNode = nullptr;
-    sGeneralLLAllocatorNode* bestNode = nullptr;
-    size_t padding = 0;
-    while(node)
+    for(size_t i = 0u; i < trace->opCount; i++)
     {
-        padding = _calc_padding_with_header((uintptr_t)node, (uintptr_t)alignment, sizeof(sGeneralLLAllocatorHeader));
-        size_t requiredSpace = size + padding;
-        if(node->blockSize >= requiredSpace && (node->blockSize - requiredSpace < smallestDiff))
+        while(i - consumed.load(std::memory_order_acquire) >= trace->slotCount)
+            std::this_thread::yield();
+        void* ptr = nullptr;
+        auto start = std::chrono::steady_clock::now();
+        if(subject->threadSafe)
+            ptr = subject->request(subject, trace->ops[i].size);
+        else
         {
-            bestNode = node;
-            smallestDiff = node->blockSize - requiredSpace;
-            if (padding_) *padding_ = padding;
-            if (prev_node_) *prev_node_ = prevNode;
+            std::lock_guard<std::mutex> lock(allocatorMutex);
+            ptr = subject->request(subject, trace->ops[i].size);
         }
-        prevNode = node;
-        node = node->nextNode;
+        latencies[i] = _bench_elapsed_ns(start);
+        if(ptr) *(unsigned char*)ptr = 1u; // touch
+        else producerFailures++;
+        ring[i % trace->slotCount] = ptr;
+        produced.store(i + 1u, std::memory_order_release);
     }
 
-    return bestNode;
+    consumer.join();
+    free(ring);
+    *failures += producerFailures;
+    return 2u * trace->opCount;
 }
 
-void*
-sGeneralLLAllocator::request_aligned_memory(size_t size, size_t alignment)
+static int
+_bench_compare_latency(const void* a, const void* b)
 {
-    if(autoCorrectAlignment) alignment = Semper::get_next_power_of_2(alignment);
-    S_MEMORY_ASSERT(size > 0u);
+    unsigned int lhs = *(const unsigned int*)a;
+    unsigned int rhs = *(const unsigned int*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
 
-    alignment = alignment < 8 ? 8 : alignment;
-    size = size < sizeof(sGeneralLLAllocatorNode) ? sizeof(sGeneralLLAllocatorNode) : size;
+static void
+_bench_run(sBenchSubject_* subject, sBenchTrace_* trace, sMemoryBenchmarkResult* result)
+{
+    size_t latencyCapacity = trace->threaded ? 2u * trace->opCount : trace->opCount;
+    unsigned int* latencies = (unsigned int*)malloc(latencyCapacity * sizeof(unsigned int));
+    void** slots = (void**)calloc(trace->slotCount, sizeof(void*));
+
+    *result = {};
+    result->allocator = subject->name;
+    result->trace = trace->name;
+    result->fragmentation = -1.0f;
+
+    subject->create(subject, trace);
+    auto start = std::chrono::steady_clock::now();
+    size_t timedCount = trace->threaded ? _bench_replay_threaded(subject, trace, latencies, &result->failures)
+                                        : _bench_replay(subject, trace, slots, latencies, &result->failures);
+    result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(subject->fragmentation)
+        result->fragmentation = subject->fragmentation(subject);
+
+    // release survivors (untimed)
+    for(size_t i = 0u; i < trace->slotCount; i++)
+    {
+        if(slots[i] && subject->canReturnAny)
+            subject->release(subject, slots[i]);
+    }
+    subject->destroy(subject);
 
-    size_t padding = 0;  
-    sGeneralLLAllocatorNode *node = nullptr;
-    sGeneralLLAllocatorNode *prev_node = nullptr;
-    switch(placementPolicy)
+    qsort(latencies, timedCount, sizeof(unsigned int), _bench_compare_latency);
+    result->operations = timedCount;
+    result->opsPerSecond = result->seconds > 0.0 ? (double)timedCount / result->seconds : 0.0;
+    if(timedCount > 0u)
     {
-        case S_ALLOC_PLACEMENT_POLICY_FIND_BEST:  node = _request_aligned_memory_find_best(this, size, alignment, &padding, &prev_node); break;
-        case S_ALLOC_PLACEMENT_POLICY_FIND_FIRST: node = _request_aligned_memory_find_first(this, size, alignment, &padding, &prev_node); break;
+        result->p50  = latencies[(size_t)(0.5   * (timedCount - 1u))];
+        result->p99  = latencies[(size_t)(0.99  * (timedCount - 1u))];
+        result->p999 = latencies[(size_t)(0.999 * (timedCount - 1u))];
+        result->max  = latencies[timedCount - 1u];
     }
 
-    if (node == nullptr) 
+    free(slots);
+    free(latencies);
+}
+
+static double
+_bench_random_access(unsigned char* memory, size_t size, size_t accesses)
+{
+    size_t words = size / sizeof(uint64_t);
+    uint64_t* data = (uint64_t*)memory;
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t sum = 0u;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0u; i < accesses; i++)
     {
-        S_MEMORY_ASSERT(false && "Free list has no free memory");
-        return nullptr;
+        state = state * 6364136223846793005ull + 1442695040888963407ull; // LCG
+        sum += data[(state >> 17) % words]++;
     }
-    
-    size_t alignment_padding = padding - sizeof(sGeneralLLAllocatorHeader);
-    size_t required_space = size + padding;
-    used += required_space;
-    size_t remaining = node->blockSize - required_space;
-    
-    if (remaining > 0) 
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile uint64_t sink = sum; (void)sink;
+    return seconds * 1.0e9 / (double)accesses;
+}
+
+int
+Semper::run_page_benchmark(sPageBenchmarkResult* results, int maxResults, size_t arenaSize, size_t accesses)
+{
+    S_MEMORY_ASSERT(results);
+    struct { const char* name; bool useDefault; sPageFlags flags; } backends[] =
     {
-        auto new_node = (sGeneralLLAllocatorNode*)((char *)node + required_space);
-        new_node->blockSize = remaining;
-        _insert_node(&head, node, new_node);
+        {"default",          true,  S_PAGE_FLAGS_NONE},
+        {"page",             false, S_PAGE_FLAGS_NONE},
+        {"page_prefault",    false, S_PAGE_FLAGS_PREFAULT},
+        {"page_huge",        false, S_PAGE_FLAGS_HUGE_PAGES},
+        {"page_huge_prefault", false, S_PAGE_FLAGS_HUGE_PAGES | S_PAGE_FLAGS_PREFAULT},
+    };
+
+    int resultCount = 0;
+    for (int i = 0; i < (int)(sizeof(backends) / sizeof(backends[0])) && resultCount < maxResults; i++)
+    {
+        sPageBenchmarkResult& result = results[resultCount++];
+        result = {};
+        result.backend = backends[i].name;
+
+        sAllocator parent = backends[i].useDefault ? Semper::get_default_allocator() : Semper::get_page_allocator(backends[i].flags);
+        sLinearAllocator arena{};
+        auto start = std::chrono::steady_clock::now();
+        arena.initialize(arenaSize, parent);
+        result.initializeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // first pass pays for any page faults left, second pass is steady state
+        unsigned char* memory = (unsigned char*)arena.request_memory(arenaSize);
+        start = std::chrono::steady_clock::now();
+        _page_touch(memory, arenaSize, 4096u);
+        result.firstTouchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.randomAccessNs = _bench_random_access(memory, arenaSize, accesses);
+        arena.free_memory();
     }
-    _remove_node(&head, prev_node, node);
-    
-    auto header_ptr = (sGeneralLLAllocatorHeader*)((char*)node + alignment_padding);
-    header_ptr->blockSize = required_space;
-    header_ptr->padding = alignment_padding;
-       
-    return ((char *)header_ptr + sizeof(sGeneralLLAllocatorHeader));
+    return resultCount;
 }
 
 void
-sGeneralLLAllocator::return_memory(void* ptr)
+Semper::print_page_benchmark(const sPageBenchmarkResult* results, int count)
 {
-    S_MEMORY_ASSERT(ptr);
-    if (ptr == nullptr) return;
-    
-    auto header = (sGeneralLLAllocatorHeader*)((char*)ptr - sizeof(sGeneralLLAllocatorHeader));
-    auto free_node = (sGeneralLLAllocatorNode*)header;
-    free_node->blockSize = header->blockSize + header->padding;
-    free_node->nextNode = nullptr;
-    
-    sGeneralLLAllocatorNode *node = head;
-    sGeneralLLAllocatorNode* prev_node = nullptr;
-    while (node != nullptr) 
+    printf("%-20s %14s %14s %18s\n", "backend", "initialize(ms)", "first touch(ms)", "random access(ns)");
+    for (int i = 0; i < count; i++)
+        printf("%-20s %14.2f %14.2f %18.2f\n", results[i].backend, results[i].initializeSeconds * 1.0e3, results[i].firstTouchSeconds * 1.0e3, results[i].randomAccessNs);
+}
+
+int
+Semper::run_memory_benchmark(sMemoryBenchmarkResult* results, int maxResults, size_t operations)
+{
+    S_MEMORY_ASSERT(results);
+    S_MEMORY_ASSERT(operations > 0u);
+
+    sBenchTrace_ traces[4];
+    _bench_generate_frame_churn      (&traces[0], operations, 0x9E3779B9u);
+    _bench_generate_parser_burst     (&traces[1], operations, 0x85EBCA6Bu);
+    _bench_generate_long_short_mix   (&traces[2], operations, 0xC2B2AE35u);
+    _bench_generate_producer_consumer(&traces[3], operations, 0x27D4EB2Fu);
+
+    static sBenchSubject_ subjects[8]; // allocators are large-ish, keep off the stack
+    _bench_subject(&subjects[0], "malloc", true, false, true);
+    subjects[0].create = _bench_malloc_create;   subjects[0].destroy = _bench_malloc_destroy;
+    subjects[0].request = _bench_malloc_request; subjects[0].release = _bench_malloc_release;
+
+    _bench_subject(&subjects[1], "linear", false, true, false);
+    subjects[1].create = _bench_linear_create;   subjects[1].destroy = _bench_linear_destroy;
+    subjects[1].request = _bench_linear_request; subjects[1].release = _bench_linear_release;
+    subjects[1].reset = _bench_linear_reset;
+
+    _bench_subject(&subjects[2], "stack", false, true, false);
+    subjects[2].create = _bench_stack_create;   subjects[2].destroy = _bench_stack_destroy;
+    subjects[2].request = _bench_stack_request; subjects[2].release = _bench_stack_release;
+    subjects[2].reset = _bench_stack_reset;
+
+    _bench_subject(&subjects[3], "pool", true, false, false);
+    subjects[3].create = _bench_pool_create;   subjects[3].destroy = _bench_pool_destroy;
+    subjects[3].request = _bench_pool_request; subjects[3].release = _bench_pool_release;
+
+    _bench_subject(&subjects[4], "general_ll_first", true, false, false, S_ALLOC_PLACEMENT_POLICY_FIND_FIRST);
+    _bench_subject(&subjects[5], "general_ll_best", true, false, false, S_ALLOC_PLACEMENT_POLICY_FIND_BEST);
+    for(int i = 4; i < 6; i++)
     {
-        if (ptr < node) 
-        {
-            _insert_node(&head, prev_node, free_node);
-            break;
-        }
-        prev_node = node;
-        node = node->nextNode;
+        subjects[i].create = _bench_general_create;   subjects[i].destroy = _bench_general_destroy;
+        subjects[i].request = _bench_general_request; subjects[i].release = _bench_general_release;
+        subjects[i].fragmentation = _bench_general_fragmentation;
     }
-    
-    used -= free_node->blockSize;
 
-    if(prev_node == nullptr) // end of list
-        return;
+    _bench_subject(&subjects[6], "frame_ring", false, true, false);
+    subjects[6].create = _bench_frame_ring_create;   subjects[6].destroy = _bench_frame_ring_destroy;
+    subjects[6].request = _bench_frame_ring_request; subjects[6].release = _bench_linear_release;
+    subjects[6].reset = _bench_frame_ring_reset;
 
-    
-    // coalescence
-    if (free_node->nextNode != nullptr && (void *)((char *)free_node + free_node->blockSize) == free_node->nextNode) 
+    _bench_subject(&subjects[7], "bitmap_pool", true, false, false);
+    subjects[7].create = _bench_bitmap_pool_create;   subjects[7].destroy = _bench_bitmap_pool_destroy;
+    subjects[7].request = _bench_bitmap_pool_request; subjects[7].release = _bench_bitmap_pool_release;
+
+    int resultCount = 0;
+    for(int t = 0; t < 4; t++)
     {
-        free_node->blockSize += free_node->nextNode->blockSize;
-        _remove_node(&head, free_node, free_node->nextNode);
+        for(int s = 0; s < 8; s++)
+        {
+            if(traces[t].needsReturnAny && !subjects[s].canReturnAny)
+                continue;
+            if(resultCount == maxResults)
+                break;
+            _bench_run(&subjects[s], &traces[t], &results[resultCount++]);
+        }
     }
-    
-    if (prev_node->nextNode != nullptr && (void *)((char *)prev_node + prev_node->blockSize) == free_node) 
+
+    for(int t = 0; t < 4; t++)
+        free(traces[t].ops);
+    return resultCount;
+}
+
+void
+Semper::print_memory_benchmark(const sMemoryBenchmarkResult* results, int count)
+{
+    printf("%-18s %-18s %10s %10s %10s %10s %10s %8s %6s\n", "trace", "allocator", "Mops/s", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)", "failures", "frag");
+    for(int i = 0; i < count; i++)
     {
-        prev_node->blockSize += free_node->nextNode->blockSize;
-        _remove_node(&head, prev_node, free_node);
+        const sMemoryBenchmarkResult& r = results[i];
+        printf("%-18s %-18s %10.2f %10.0f %10.0f %10.0f %10.0f %8zu ", r.trace, r.allocator, r.opsPerSecond / 1.0e6, r.p50, r.p99, r.p999, r.max, r.failures);
+        if(r.fragmentation < 0.0f) printf("%6s\n", "-");
+        else                       printf("%6.3f\n", r.fragmentation);
     }
 }
 
+#endif // SEMPER_MEMORY_BENCHMARK
+
 static size_t
 Semper::get_next_power_of_2(size_t n)
 {